@@ -0,0 +1,653 @@
+#ifndef ACCEL_H
+# define ACCEL_H
+
+# include "intersections.h"
+# include "options.h"
+# include <pthread.h>
+
+/* Plane kernel batch size, kept on the stack */
+# define PLANE_CHUNK 32
+
+/* BVH: SAH bins per axis, leaf sizes, traversal stack depth */
+# define BVH_BINS 12
+# define BVH_LEAF_SIZE 2
+# define BVH_MAX_LEAF 8
+# define BVH_TRAVERSAL_COST 1.0
+# define BVH_STACK_SIZE 64
+# define ERR_BVH_STACK "Error: BVH traversal stack overflow\n"
+
+/*
+** Depth from which ranges are halved instead of split by the builder:
+** a traversal holds at most one node per level plus one, so leaves must
+** sit above BVH_STACK_SIZE, and 2^31 objects halve down to leaves within
+** 31 levels
+*/
+# define BVH_BALANCE_DEPTH 32
+
+/*
+** Lazy BVH: levels built at load; deeper nodes stay BVH_PENDING (in
+** node.left) until a ray first reaches them
+*/
+# define BVH_LAZY_DEPTH 6
+# define BVH_PENDING -1
+
+/*
+** Parallel build: ranges of at least BVH_PARALLEL_BIN_MIN objects are
+** binned by several threads, subtrees of at least BVH_PARALLEL_TASK_MIN
+** objects are built on their own thread, up to BVH_MAX_THREADS threads
+*/
+# define BVH_PARALLEL_BIN_MIN 65536
+# define BVH_PARALLEL_TASK_MIN 4096
+# define BVH_MAX_THREADS 16
+
+/*
+** Wide BVH: children per node, traversal stack depth, bound padding
+** relative to the coordinates (covers float rounding) and the float
+** stand-in for an unbounded tmax
+** A wide node lies no deeper than the binary interior node it starts
+** from (at most BVH_STACK_SIZE - 2), and each level it sits below adds
+** at most BVH_WIDTH - 1 children to the stack
+*/
+# define BVH_WIDTH 4
+# define WBVH_STACK_SIZE 190
+# define WBVH_PAD 1e-6
+# define WBVH_FAR 1e30
+
+/* LBVH: bits per axis of the Morton codes */
+# define MORTON_BITS 10
+
+/* Rebuild the BVH once refits raise its SAH cost by this factor */
+# define BVH_REBUILD_RATIO 1.3
+
+/* Screen tiles binning the view list for primary rays (flat list) */
+# define TILE_SIZE 16
+# define TILES_X ((WIDTH + TILE_SIZE - 1) / TILE_SIZE)
+# define TILES_Y ((HEIGHT + TILE_SIZE - 1) / TILE_SIZE)
+
+/*
+** Shadow-caster lists are only kept for scenes of at most this many
+** objects; building them is quadratic
+*/
+# define CASTER_MAX_OBJECTS 2048
+
+/*
+** Tile shadow pass: shadow rays per packet (four double lanes), and the
+** largest scene whose objects are culled once per screen tile
+*/
+# define SHADOW_PACKET 4
+# define SHADOW_TILE_MAX_OBJECTS 4096
+
+/*
+** Light cache (--light-cache): slots in the hash table (a power of two),
+** slots probed per lookup, cell edge in world units, and the largest
+** coordinate that is quantised (farther hits are not cached)
+*/
+# define LIGHT_CACHE_SIZE 262144
+# define LIGHT_CACHE_PROBE 4
+# define LIGHT_CACHE_CELL 0.05
+# define LIGHT_CACHE_RANGE 1e6
+
+/*
+** Shadow map (--shadows map): edge in texels of the blocks traced on
+** demand, and the smallest cosine the slope-scaled bias divides by
+*/
+# define SHADOW_MAP_BLOCK 16
+# define SHADOW_MAP_MIN_COS 0.1
+
+/* Grid: target objects per cell and resolution cap per axis */
+# define GRID_DENSITY 2.0
+# define GRID_MAX_RES 64
+
+/* Axis-aligned bounding box */
+typedef struct s_aabb
+{
+	t_vec3			min;
+	t_vec3			max;
+}					t_aabb;
+
+/*
+** Unbounded planes in structure-of-arrays form, so the plane kernel
+** vectorises: plane k is dot(n_k, p) = d_k, object index[k]
+*/
+typedef struct s_plane_list
+{
+	double			*nx;
+	double			*ny;
+	double			*nz;
+	double			*d;
+	int				*index;
+	int				count;
+}					t_plane_list;
+
+/*
+** BVH node: leaves own prims[first, first + count); interior nodes have
+** count == 0 and children left and left + 1; pending nodes (lazy trees)
+** own their objects like leaves, with left == BVH_PENDING
+*/
+typedef struct s_bvh_node
+{
+	t_aabb			box;
+	int				left;
+	int				first;
+	int				count;
+}					t_bvh_node;
+
+/*
+** Bounding volume hierarchy over the bounded objects
+** prims holds object indices, reordered so each leaf is contiguous
+** parent[node] and leaf_of[object] let an edit refit one leaf-to-root
+** path; cost is the SAH sum (node area times node cost) kept up to date
+** by refits, build_cost the same sum when the tree was built
+*/
+typedef struct s_bvh
+{
+	t_bvh_node		*nodes;
+	int				num_nodes;
+	int				*prims;
+	int				num_prims;
+	int				*parent;
+	int				*leaf_of;
+	unsigned int	*codes;
+	double			cost;
+	double			build_cost;
+}					t_bvh;
+
+/* Four floats or ints, one SSE register; comparisons give t_v4i masks */
+typedef float		t_v4f __attribute__((vector_size(16)));
+typedef int			t_v4i __attribute__((vector_size(16)));
+
+/* Four doubles or longs, the lanes of a shadow packet */
+typedef double		t_v4d __attribute__((vector_size(32)));
+typedef long		t_v4l __attribute__((vector_size(32)));
+
+/*
+** Wide BVH node, collapsed from the binary tree: up to BVH_WIDTH children
+** whose boxes are quantised to 8 bits per bound inside the node's own box,
+** bound q on an axis decoding to origin + q * scale (68 bytes)
+** A child with count > 0 is a leaf over prims[child, child + count),
+** one with count == 0 another wide node, child -1 marks an unused slot
+*/
+typedef struct s_wide_node
+{
+	float			origin[3];
+	float			scale[3];
+	unsigned char	lo[3][BVH_WIDTH];
+	unsigned char	hi[3][BVH_WIDTH];
+	int				child[BVH_WIDTH];
+	unsigned char	count[BVH_WIDTH];
+}					t_wide_node;
+
+/* Wide BVH over the binary BVH's prims; node 0 is the root */
+typedef struct s_wbvh
+{
+	t_wide_node		*nodes;
+	int				num_nodes;
+}					t_wbvh;
+
+/*
+** Uniform grid over the bounded objects: cell c lists the object indices
+** cell_items[cell_start[c], cell_start[c + 1])
+*/
+typedef struct s_grid
+{
+	t_aabb			box;
+	int				res[3];
+	t_vec3			cell_size;
+	t_vec3			inv_cell_size;
+	int				num_cells;
+	int				*cell_start;
+	int				*cell_items;
+}					t_grid;
+
+/*
+** 3D-DDA walk through the grid: current cell, step direction per axis,
+** distance to the next cell boundary per axis and between boundaries
+*/
+typedef struct s_dda
+{
+	int				cell[3];
+	int				step[3];
+	double			next[3];
+	double			delta[3];
+	double			exit;
+}					t_dda;
+
+/* Slice of bvh.prims being split, with its bounds */
+typedef struct s_prim_range
+{
+	int				*prims;
+	int				count;
+	t_aabb			box;
+}					t_prim_range;
+
+/* BVH traversal stack: nodes still to visit and where the ray enters them */
+typedef struct s_bvh_stack
+{
+	int				node[BVH_STACK_SIZE];
+	double			entry[BVH_STACK_SIZE];
+	int				size;
+	t_vec3			inv_dir;
+	double			tmax;
+}					t_bvh_stack;
+
+/*
+** Wide BVH traversal stack: children still to visit (as in t_wide_node)
+** and where the ray enters them, with the ray in single precision
+*/
+typedef struct s_wbvh_stack
+{
+	int				child[WBVH_STACK_SIZE];
+	int				count[WBVH_STACK_SIZE];
+	float			entry[WBVH_STACK_SIZE];
+	int				size;
+	float			origin[3];
+	float			inv_dir[3];
+	float			tmax;
+}					t_wbvh_stack;
+
+/* SAH bin: bounds and number of the objects whose centroid falls in it */
+typedef struct s_bin
+{
+	t_aabb			box;
+	int				count;
+}					t_bin;
+
+/*
+** SAH bins of a range on all three axes, spread over the centroid bounds
+** from lo[axis] with scale[axis] bins per unit (0 for unsplittable axes)
+*/
+typedef struct s_binning
+{
+	t_bin			bins[3][BVH_BINS];
+	double			lo[3];
+	double			scale[3];
+}					t_binning;
+
+/* Candidate SAH split: objects with centroid bin <= bin go left */
+typedef struct s_split
+{
+	int				axis;
+	int				bin;
+	double			cost;
+	double			lo;
+	double			scale;
+}					t_split;
+
+/*
+** Object in the view frustum, with the distance from the camera to its
+** box and the screen tiles its box covers (x0, y0, x1, y1, inclusive)
+*/
+typedef struct s_view_item
+{
+	double			near;
+	int				object;
+	int				rect[4];
+}					t_view_item;
+
+/*
+** Bounded objects in the view frustum, sorted front to back; rebuilt per
+** frame for the primary rays of the flat list (ACCEL_NONE)
+*/
+typedef struct s_view_list
+{
+	t_view_item		*items;
+	t_view_item		*scratch;
+	int				count;
+}					t_view_list;
+
+/*
+** View-list entries per screen tile, binned with the camera they were
+** projected for: tile t holds tile_items[tile_start[t],
+** tile_start[t + 1]), front to back
+*/
+typedef struct s_tile_bins
+{
+	t_view			camera;
+	int				*tile_start;
+	int				*tile_items;
+	int				capacity;
+}					t_tile_bins;
+
+/*
+** Origin terms of every object for rays starting at origin (the camera
+** for primary rays, the light for shadow rays), refreshed before each
+** frame; planes are skipped
+*/
+typedef struct s_origin_cache
+{
+	t_point3		origin;
+	t_origin_terms	*terms;
+	int				valid;
+}					t_origin_cache;
+
+/*
+** Cone from the light around an object's bounding sphere: unit axis
+** towards the sphere's centre and squared cosine of its half angle,
+** negative when the light is inside the sphere (the cone is everything)
+** The half angle's cosine and sine and the sphere's nearest and farthest
+** distances from the light serve the caster lists
+*/
+typedef struct s_bound_cone
+{
+	t_vec3			axis;
+	double			cos_sq;
+	double			cos;
+	double			sin;
+	double			near;
+	double			far;
+}					t_bound_cone;
+
+/*
+** Potential occluders of each receiver for shadow rays from light:
+** object r can only be shadowed by the bounded objects items[start[r],
+** start[r + 1]) and by num_planes[r] planes; receivers with any plane
+** caster test the whole plane list, its kernel beating a per-plane loop
+** valid is cleared by edits and the lists are rebuilt before the next
+** frame, or whenever the light moves
+*/
+typedef struct s_caster_lists
+{
+	t_point3		light;
+	int				*start;
+	int				*num_planes;
+	int				*items;
+	int				capacity;
+	int				valid;
+}					t_caster_lists;
+
+/*
+** Shadow work of one screen tile: the pixels whose hits face the light
+** (a queue of up to TILE_SIZE^2, owned by the caller), the sphere around
+** their hit points and its cone from the light, and the objects that
+** cone keeps: spheres at the front of casters, for the packets,
+** cylinders and cones at the back; planes is set if any plane may block
+** the light
+*/
+typedef struct s_shadow_tile
+{
+	int				*pixels;
+	int				count;
+	t_point3		center;
+	double			radius;
+	t_bound_cone	cone;
+	int				*casters;
+	int				num_spheres;
+	int				num_others;
+	int				planes;
+}					t_shadow_tile;
+
+/*
+** Up to SHADOW_PACKET shadow rays of a tile from pixel first on, all cast
+** from the light: directions, dot(dir, dir) and the sphere kernel's b in
+** lanes; open marks the lanes not yet occluded, maybe those a sphere's
+** discriminant test let through
+*/
+typedef struct s_shadow_packet
+{
+	t_v4d			dir[3];
+	t_v4d			a;
+	t_v4d			b;
+	t_v4l			open;
+	t_v4l			maybe;
+	t_ray			rays[SHADOW_PACKET];
+	int				first;
+	int				count;
+	int				num_open;
+}					t_shadow_packet;
+
+/*
+** Shadow state of the hits of object in one world-space cell, valid while
+** stamp matches the cache's; 0 stamps an empty slot
+*/
+typedef struct s_light_entry
+{
+	int				object;
+	int				cell[3];
+	unsigned int	stamp;
+	int				lit;
+}					t_light_entry;
+
+/*
+** World-space cache of shadow states, filled as hits are shaded and kept
+** across frames and camera moves; bumping stamp empties it when the light
+** moves, object edits clear only the entries the object may shadow
+** entries is NULL unless the cache is enabled
+*/
+typedef struct s_light_cache
+{
+	t_light_entry	*entries;
+	unsigned int	stamp;
+	t_point3		light;
+	int				valid;
+}					t_light_cache;
+
+/*
+** Cube depth map from the light (--shadows map): face f looks along axis
+** f / 2, negatively if f is odd, and holds res x res distances from the
+** light to the nearest surface; blocks of SHADOW_MAP_BLOCK^2 texels are
+** traced when a lookup first lands in them, and all are dropped when the
+** light moves or an object is edited (valid cleared)
+** depth is NULL unless the mode is selected; bias is in texels
+*/
+typedef struct s_shadow_map
+{
+	float			*depth;
+	char			*block_valid;
+	int				res;
+	int				blocks;
+	double			bias;
+	t_point3		light;
+	int				valid;
+}					t_shadow_map;
+
+/*
+** Background BVH rebuild: the thread builds snapshot->bvh from a copy of
+** the bounds while the current tree keeps serving rays; done is set
+** under lock when the new tree is ready to be swapped in
+*/
+typedef struct s_bvh_rebuild
+{
+	pthread_t		thread;
+	pthread_mutex_t	lock;
+	int				running;
+	int				done;
+	struct s_accel	*snapshot;
+}					t_bvh_rebuild;
+
+/*
+** Scene acceleration data, rebuilt from the object array
+** planes are tested first; their nearest hit seeds tmax for the bounded
+** objects, found through the structure selected by mode
+** The wide BVH is collapsed from the binary one, which is kept for refits
+** build picks the BVH builder, threads how many threads it may use
+** lazy_lock serialises the splitting of pending nodes during traversal
+** tile_casters holds the objects the tile shadow pass keeps for a tile
+** light_cache holds the shadow states of shaded hits, with --light-cache
+** shadow_map replaces shadow rays with --shadows map
+*/
+typedef struct s_accel
+{
+	int				mode;
+	int				build;
+	int				threads;
+	int				num_objects;
+	t_plane_list	planes;
+	t_aabb			*bounds;
+	int				*bounded;
+	int				num_bounded;
+	t_bvh			bvh;
+	t_wbvh			wbvh;
+	t_bvh_rebuild	rebuild;
+	pthread_mutex_t	lazy_lock;
+	t_grid			grid;
+	t_view_list		view;
+	t_tile_bins		tiles;
+	t_origin_cache	camera;
+	t_origin_cache	light;
+	t_bound_cone	*light_cones;
+	t_caster_lists	casters;
+	int				*tile_casters;
+	t_light_cache	light_cache;
+	t_shadow_map	shadow_map;
+}					t_accel;
+
+/*
+** BVH subtree to build: node over prims[first, first + count), at depth
+** in the tree; lazy trees leave nodes at lazy_depth pending
+*/
+typedef struct s_build_task
+{
+	t_accel			*accel;
+	int				node;
+	int				first;
+	int				count;
+	int				depth;
+	int				lazy_depth;
+}					t_build_task;
+
+/* LBVH radix sort: codes and prims ping-pong between buffers 0 and 1 */
+typedef struct s_morton_sort
+{
+	unsigned int	*codes[2];
+	int				*prims[2];
+	int				count;
+}					t_morton_sort;
+
+/* Share of a range binned by one thread */
+typedef struct s_bin_job
+{
+	const t_accel	*accel;
+	const int		*prims;
+	int				count;
+	t_binning		binning;
+}					t_bin_job;
+
+/* Construction and updates */
+void				accel_build(t_scene *scene, const t_options *opts);
+void				accel_free(t_scene *scene);
+void				accel_update_object(t_scene *scene, int obj_index);
+void				accel_poll(t_scene *scene);
+void				accel_view_update(t_scene *scene);
+void				origin_cache_update(t_origin_cache *cache,
+						const t_scene *scene, t_point3 origin);
+int					origin_cache_matches(const t_origin_cache *cache,
+						t_point3 origin);
+void				light_cones_update(t_accel *accel, const t_scene *scene);
+double				object_bound_sphere(const t_object *obj,
+						t_point3 *center);
+void				caster_lists_update(t_accel *accel,
+						const t_scene *scene);
+void				caster_lists_free(t_caster_lists *casters);
+void				bound_cone_init(t_bound_cone *cone, t_point3 center,
+						double radius_sq, t_point3 light);
+int					bound_cones_overlap(const t_bound_cone *occluder,
+						const t_bound_cone *receiver);
+int					bound_cone_rejects(const t_bound_cone *cone, t_vec3 dir);
+double				plane_light_side(const t_plane *plane, t_point3 light,
+						t_point3 p);
+int					caster_may_shadow(const t_scene *scene,
+						const t_accel *accel, int occluder, int receiver);
+void				light_cache_init(t_light_cache *cache, int enabled);
+void				light_cache_update(t_light_cache *cache,
+						const t_scene *scene);
+void				light_cache_invalidate(t_accel *accel,
+						const t_scene *scene, int obj_index);
+void				light_cache_free(t_light_cache *cache);
+int					light_cache_lookup(const t_scene *scene,
+						const t_hit *hit);
+void				light_cache_store(const t_scene *scene,
+						const t_hit *hit, int lit);
+void				shadow_map_init(t_shadow_map *map, const t_options *opts);
+void				shadow_map_update(t_shadow_map *map,
+						const t_scene *scene);
+void				shadow_map_free(t_shadow_map *map);
+int					shadow_map_lit(const t_scene *scene, const t_hit *hit);
+void				view_sort(t_view_list *view);
+void				view_tiles_build(t_accel *accel, const t_view *camera);
+int					view_tile_coord(double pixel, int tiles);
+void				plane_list_build(t_plane_list *list,
+						const t_scene *scene);
+void				plane_list_free(t_plane_list *list);
+void				bvh_build(t_accel *accel);
+void				bvh_alloc(t_accel *accel);
+void				bvh_free(t_bvh *bvh);
+void				bvh_refit(t_bvh *bvh, const t_aabb *bounds, int obj);
+void				bvh_refit_all(t_bvh *bvh, const t_aabb *bounds);
+int					bvh_degraded(const t_bvh *bvh);
+void				bvh_start_rebuild(t_accel *accel);
+int					bvh_poll_rebuild(t_accel *accel);
+void				bvh_stop_rebuild(t_accel *accel);
+void				bvh_build_node(t_build_task *task);
+int					bvh_visit(t_accel *accel, int node);
+void				bvh_build_children(t_build_task *left,
+						t_build_task *right);
+int					bvh_find_split(const t_accel *accel,
+						const t_prim_range *range, t_split *split);
+int					bvh_bin_index(double centroid, double lo, double scale);
+t_aabb				bvh_centroid_bounds(const t_accel *accel,
+						const int *prims, int count);
+void				bvh_binning_init(t_binning *binning, t_aabb centroids);
+void				bvh_bin_range(const t_accel *accel, const int *prims,
+						int count, t_binning *binning);
+void				bvh_bin_parallel(const t_accel *accel,
+						const t_prim_range *range, t_binning *binning);
+unsigned int		morton_expand(unsigned int v);
+void				bvh_morton_sort(t_accel *accel);
+int					bvh_morton_split(const t_bvh *bvh, int first, int count);
+int					bvh_partition(const t_accel *accel,
+						t_prim_range *range, const t_split *split);
+void				wbvh_build(t_accel *accel);
+void				grid_build(t_accel *accel);
+void				grid_free(t_grid *grid);
+int					grid_cell_coord(const t_grid *grid, t_vec3 p, int axis);
+
+/* Bounds */
+int					object_bounds(const t_object *obj, t_aabb *box);
+t_vec3				ray_inverse_direction(t_ray ray);
+int					aabb_clip(const t_aabb *box, const t_ray *ray,
+						t_vec3 inv_dir, double *range);
+double				aabb_entry(const t_aabb *box, const t_ray *ray,
+						t_vec3 inv_dir, double tmax);
+int					aabb_hit(const t_aabb *box, const t_ray *ray,
+						t_vec3 inv_dir, double tmax);
+t_aabb				aabb_empty(void);
+t_aabb				aabb_union(t_aabb a, t_aabb b);
+double				aabb_area(const t_aabb *box);
+double				aabb_centroid(const t_aabb *box, int axis);
+double				vec3_component(t_vec3 v, int axis);
+
+/* Traversal */
+int					trace_planes(const t_scene *scene, t_ray ray,
+						t_hit *closest_hit);
+int					trace_primary(const t_scene *scene, t_ray ray,
+						t_hit *closest_hit, t_hints *hints);
+int					trace_shadow(const t_scene *scene, t_ray ray,
+						int receiver, t_hints *hints);
+int					trace_bounded(const t_scene *scene, t_ray ray,
+						t_hit *closest_hit);
+int					bvh_trace(const t_scene *scene, t_ray ray,
+						t_hit *closest_hit);
+int					bvh_trace_leaf(const t_scene *scene,
+						const t_bvh_node *leaf, t_ray ray, t_hit *closest_hit);
+int					wbvh_trace(const t_scene *scene, t_ray ray,
+						t_hit *closest_hit);
+t_v4i				wbvh_node_test(const t_wide_node *node,
+						const t_wbvh_stack *stack, t_v4f *entry);
+int					grid_trace(const t_scene *scene, t_ray ray,
+						t_hit *closest_hit);
+double				hit_tmax(const t_hit *hit, double tmax);
+void				hints_init(t_hints *hints);
+int					primary_hint_seed(t_hints *hints, const t_scene *scene,
+						t_ray *ray, t_hit *closest_hit);
+void				primary_hint_update(t_hints *hints, const t_scene *scene,
+						const t_hit *hit, int hit_found);
+int					occluder_hint_blocks(t_hints *hints,
+						const t_scene *scene, t_ray ray, t_hit *closest_hit);
+void				occluder_hint_update(t_hints *hints, const t_scene *scene,
+						const t_hit *hit, int blocked);
+void				shadow_tile_cull(const t_scene *scene, const t_hit *hits,
+						t_shadow_tile *tile);
+void				shadow_tile_trace(const t_scene *scene, const t_hit *hits,
+						const t_shadow_tile *tile, int *lit);
+
+#endif
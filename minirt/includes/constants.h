@@ -5,13 +5,28 @@
 # define EPSILON 0.0001
 # define MIN_T 0.001
 # define SHADOW_EPSILON 1e-6
-# define EARLY_TERMINATION_DISTANCE 0.002
 
 /* Lighting constants */
 # define LIGHTENING_FACTOR 0.4
 # define ATTENUATION_LINEAR 0.01
 # define ATTENUATION_QUADRATIC 0.001
 
+/* Reprojection constants */
+# define REPROJ_EMPTY -2
+# define REPROJ_KEEP 0
+# define REPROJ_RETRACE 1
+# define REPROJ_DEPTH_TOLERANCE 0.1
+# define REPROJ_IDLE_MS 150
+
+/* Adaptive subsampling constants */
+# define SUBSAMPLE_STEP 4
+
+/* Adaptive anti-aliasing constants */
+# define AA_CONTRAST 24
+# define AA_MIN_GRID 2
+# define AA_MAX_GRID 4
+# define AA_SAMPLE_BUDGET 120000
+
 /* Rendering constants */
 # define DEFAULT_SKY_COLOR_R 135
 # define DEFAULT_SKY_COLOR_G 206
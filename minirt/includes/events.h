@@ -52,6 +52,27 @@
 # define KEY_P_MAC 35
 # define KEY_O 111
 # define KEY_O_MAC 31
+# define KEY_Z 122
+# define KEY_Z_MAC 6
+# define KEY_X 120
+# define KEY_X_MAC 7
+# define KEY_C 99
+# define KEY_C_MAC 8
+# define KEY_V 118
+# define KEY_V_MAC 9
+# define KEY_B 98
+# define KEY_B_MAC 11
+# define KEY_N 110
+# define KEY_N_MAC 45
+# define KEY_Y 121
+# define KEY_Y_MAC 16
+# define KEY_H 104
+# define KEY_H_MAC 4
+# define KEY_U 117
+# define KEY_U_MAC 32
+# define KEY_M 109
+# define KEY_M_MAC 46
+# define MOUSE_LEFT 1
 
 /* Global variables */
 extern t_scene	*g_scene;
@@ -63,9 +84,18 @@ int				close_window_esc(int keycode, t_vars *vars);
 int				key_handler(int keycode, t_vars *vars);
 void			mlx_hooks(t_vars *vars);
 void			draw_new_image(t_vars *vars, t_scene *scene);
-void			handle_camera_movement(int keycode, t_scene *scene);
-void			handle_camera_rotation(int keycode, t_scene *scene);
+int				handle_camera_movement(int keycode, t_scene *scene);
+int				handle_camera_rotation(int keycode, t_scene *scene);
+int				handle_camera_controls(int keycode, t_vars *vars,
+					t_scene *scene);
+int				idle_handler(t_vars *vars);
 void			handle_object_transforms(int keycode, t_scene *scene);
+int				handle_light_controls(int keycode, t_vars *vars,
+					t_scene *scene);
+int				handle_object_selection(int keycode, t_vars *vars,
+					t_scene *scene);
+int				mouse_handler(int button, int x, int y, t_vars *vars);
+void			redraw_selection(t_vars *vars);
 void			print_controls_help(void);
 
 #endif
@@ -0,0 +1,46 @@
+#ifndef GBUFFER_H
+# define GBUFFER_H
+
+# include "intersections.h"
+
+/*
+** Per-pixel geometry cached from the last traced frame.
+** hits[i].t < 0 marks a sky pixel, whose colour is kept in colors[i].
+** Lighting-only edits re-shade these hits instead of re-tracing.
+** ids[i] holds the object index seen through pixel i (-1 for sky);
+** colors[i] is unhighlighted, the selection is composited on top of it.
+** lit[i] records whether the light reached the hit (facing and unshadowed).
+** blended[i] marks a pixel --subsample interpolated: its hit is blended
+** from its block's corners, off curved surfaces, so it is resolved before
+** it is shaded again (see gbuffer_resolve_blended).
+** The prev_* arrays hold the previous frame while it is reprojected
+** into the new camera; stale is set while the image is a reprojection.
+*/
+typedef struct s_gbuffer
+{
+	t_hit			*hits;
+	int				*colors;
+	int				*ids;
+	int				*lit;
+	int				*blended;
+	t_hit			*prev_hits;
+	int				*prev_colors;
+	int				*prev_ids;
+	int				*prev_blended;
+	int				valid;
+	int				stale;
+	long			last_move_ms;
+}					t_gbuffer;
+
+/*
+** Screen rectangle between lattice points [x0, x1] x [y0, y1]
+*/
+typedef struct s_block
+{
+	int				x0;
+	int				y0;
+	int				x1;
+	int				y1;
+}					t_block;
+
+#endif
@@ -14,20 +14,65 @@ typedef struct s_hit
 	int			hit_side;
 }				t_hit;
 
-int				intersect_sphere(const t_sphere *sphere, t_ray ray, t_hit *hit);
+/*
+** A cap plane of a cylinder or cone: its offset along the axis and the
+** ray origin's distance to it along the axis
+*/
+typedef struct s_cap_terms
+{
+	double		height;
+	double		dist;
+}				t_cap_terms;
+
+/*
+** The parts of an object's intersection test that depend only on the ray
+** origin, so rays sharing an origin can compute them once:
+** oc is origin - centre (apex for cones), oc_axis is cross(oc, axis),
+** c is the constant term of the quadratic, cos_sq the cone's squared
+** half-angle cosine, and bound_oc and bound_c the same kind of terms for
+** the bounding sphere, measured from the origin to its centre
+*/
+typedef struct s_origin_terms
+{
+	t_vec3		oc;
+	t_vec3		oc_axis;
+	double		oc_dot_axis;
+	double		cos_sq;
+	double		c;
+	t_cap_terms	cap[2];
+	t_vec3		bound_oc;
+	double		bound_c;
+}				t_origin_terms;
+
+int				intersect_sphere(const t_sphere *sphere, t_ray ray,
+					const t_origin_terms *terms, t_hit *hit);
 int				intersect_plane(const t_plane *plane, t_ray ray, t_hit *hit);
 int				intersect_cylinder(const t_cylinder *cylinder, t_ray ray,
-					t_hit *hit);
-int				intersect_cone(const t_cone *cone, t_ray ray, t_hit *hit);
+					const t_origin_terms *terms, t_hit *hit);
+int				intersect_cone(const t_cone *cone, t_ray ray,
+					const t_origin_terms *terms, t_hit *hit);
 int				trace_objects(const t_scene *scene, t_ray ray,
 					t_hit *closest_hit);
-t_quadratic		sphere_quadratic_coeffs(const t_sphere *sphere, t_ray ray);
-t_quadratic		cylinder_quadratic_coeffs(const t_cylinder *cylinder,
+int				trace_seeded(const t_scene *scene, t_ray ray,
+					t_hit *closest_hit);
+int				trace_object(const t_scene *scene, t_ray ray,
+					t_hit *closest_hit, int index);
+t_quadratic		sphere_quadratic_coeffs(const t_origin_terms *terms,
 					t_ray ray);
-t_quadratic		cone_quadratic_coeffs(const t_cone *cone, t_ray ray);
+t_quadratic		cylinder_quadratic_coeffs(const t_cylinder *cylinder,
+					const t_origin_terms *terms, t_ray ray);
+t_quadratic		cone_quadratic_coeffs(const t_cone *cone,
+					const t_origin_terms *terms, t_ray ray);
 t_vec3			cylinder_surface_normal(const t_cylinder *cylinder,
 					t_point3 point);
 t_vec3			cone_surface_normal(const t_cone *cone, t_point3 point);
-int				intersect_cone_cap(const t_cone *cone, t_ray ray, t_hit *hit);
+int				intersect_cone_cap(const t_cone *cone, t_ray ray,
+					const t_origin_terms *terms, t_hit *hit);
+void			object_update_bound(t_object *obj);
+void			object_bound_terms(const t_object *obj, t_point3 origin,
+					t_origin_terms *terms);
+void			object_origin_terms(const t_object *obj, t_point3 origin,
+					t_origin_terms *terms);
+int				bound_rejects(const t_origin_terms *terms, t_ray ray);
 
 #endif
@@ -18,6 +18,8 @@
 # define WINDOW_NAME_RT "miniRT"
 
 # include "constants.h"
+# include "gbuffer.h"
+# include "options.h"
 # include "intersections.h"
 # include "parser.h"
 # include "scene_math.h"
@@ -40,12 +42,15 @@ typedef struct s_image
 	int					endian;
 }						t_image;
 
-/* Main program variables structure */
+/* Main program variables structure; hints serve the per-pixel passes */
 typedef struct s_vars
 {
 	void				*mlx;
 	void				*win;
 	t_image				*img;
+	t_gbuffer			gbuf;
+	t_options			opts;
+	t_hints				hints;
 }						t_vars;
 
 typedef struct s_hit	t_hit;
@@ -55,11 +60,42 @@ void					draw_new_image(t_vars *vars, t_scene *scene);
 void					create_image(t_vars *vars);
 void					cleanup_image(t_vars *vars);
 void					main_draw(t_vars *vars, t_scene *scene);
+void					draw_first_frame(t_vars *vars, t_scene *scene);
 void					put_pixel(t_vars *vars, int x, int y, int color);
 void					cleanup_all(t_vars *vars);
 void					error_exit(char *message);
 void					print_scene_info(t_scene *scene);
 
+/* G-buffer and relighting */
+void					gbuffer_init(t_gbuffer *gbuf);
+void					gbuffer_free(t_gbuffer *gbuf);
+void					gbuffer_resolve_blended(t_vars *vars, t_scene *scene);
+void					relight_image(t_vars *vars, t_scene *scene);
+int						shade_hit(const t_scene *scene, const t_hit *hit,
+							int *lit, t_hints *hints);
+void					composite_image(t_vars *vars);
+void					trace_pixel(t_vars *vars, t_scene *scene, int x, int y);
+void					trace_all_pixels(t_vars *vars, t_scene *scene);
+void					antialias_edges(t_vars *vars, t_scene *scene);
+
+/* Adaptive subsampling */
+void					subsample_draw(t_vars *vars, t_scene *scene);
+int						is_lattice_point(int x, int y);
+void					interpolate_pixel(t_gbuffer *gbuf, const t_block *b,
+							int x, int y);
+void					report_subsample_quality(t_vars *vars,
+							t_scene *scene);
+void					report_order_benchmark(t_vars *vars,
+							t_scene *scene);
+
+/* Temporal reprojection */
+void					reproject_draw(t_vars *vars, t_scene *scene);
+void					retrace_invalid_pixels(t_vars *vars, t_scene *scene);
+long					time_now_ms(void);
+long					time_now_us(void);
+int						cpu_count(void);
+int						get_selected_object_index(void);
+
 /* Error utility functions */
 void					ft_print_error(const char *message);
 void					ft_print_error_detail(const char *message,
@@ -76,10 +112,13 @@ t_color3				clamp_color(t_color3 color);
 t_color3				calculate_ambient(const t_scene *scene,
 							const t_hit *hit);
 t_color3				calculate_diffuse(const t_scene *scene,
-							const t_hit *hit);
+							const t_hit *hit, int lit);
+int						is_lit(const t_scene *scene, const t_hit *hit,
+							t_hints *hints);
 int						is_in_shadow(const t_scene *scene, const t_vec3 point,
-							const t_vec3 light_pos);
+							int receiver, t_hints *hints);
+t_ray					shadow_ray(const t_vec3 point, const t_vec3 light_pos);
 t_color3				calculate_lighting(const t_scene *scene,
-							const t_hit *hit);
+							const t_hit *hit, int lit);
 
 #endif
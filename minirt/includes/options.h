@@ -0,0 +1,83 @@
+#ifndef OPTIONS_H
+# define OPTIONS_H
+
+# define ERR_USAGE "Usage: ./miniRT scene.rt [options] (see README)\n"
+
+/* Structures for the bounded objects, selected with --accel */
+# define ACCEL_NONE 0
+# define ACCEL_BVH 1
+# define ACCEL_GRID 2
+# define ACCEL_WBVH 3
+# define ACCEL_LAZY 4
+
+/* BVH builders, selected with --bvh-build */
+# define BVH_BUILD_SAH 0
+# define BVH_BUILD_LBVH 1
+
+/* Shadow modes, selected with --shadows */
+# define SHADOWS_RAY 0
+# define SHADOWS_MAP 1
+
+/* Lowest PSNR (dB) of the subsampled render --quality-check accepts */
+# define QUALITY_MIN_PSNR 40.0
+
+/* Pixel orders of full frames, selected with --order */
+# define ORDER_SCANLINE 0
+# define ORDER_TILED 1
+# define ORDER_MORTON 2
+# define ORDER_HILBERT 3
+# define ORDERS 4
+
+/* Full frames timed per order by --bench-order, keeping the fastest */
+# define BENCH_ORDER_RUNS 3
+
+/*
+** Shadow map: default texels per cube face edge (--shadow-res) and its
+** bounds, and default depth bias in texels (--shadow-bias)
+*/
+# define SHADOW_MAP_RES 512
+# define SHADOW_MAP_MIN_RES 16
+# define SHADOW_MAP_MAX_RES 4096
+# define SHADOW_MAP_BIAS 1.5
+
+/*
+** Render options selected on the command line
+** subsample: trace a sparse lattice and interpolate flat regions
+** quality_check: compare the first frame against a full render, and exit
+** antialias: supersample edge pixels after the primary pass
+** stats: print the render counters after each full frame
+** accel: ACCEL_NONE, ACCEL_BVH, ACCEL_GRID, ACCEL_WBVH or ACCEL_LAZY for
+** the bounded objects
+** bvh_build: BVH_BUILD_SAH (binned SAH) or BVH_BUILD_LBVH (Morton codes)
+** light_cache: reuse shadow states across frames from a world-space cache
+** shadows: SHADOWS_RAY (a shadow ray per hit) or SHADOWS_MAP (a cube depth
+** map rendered from the light), with shadow_res texels per face edge and
+** a depth bias of shadow_bias texels
+** sort_rays: sort each tile's shadow rays by direction octant and Morton
+** code before tracing them
+** order: ORDER_SCANLINE, ORDER_TILED, ORDER_MORTON or ORDER_HILBERT, the
+** order full frames trace their pixels in
+** bench_order: time the first frame in every order instead of drawing it
+*/
+typedef struct s_options
+{
+	int		subsample;
+	int		quality_check;
+	int		antialias;
+	int		stats;
+	int		accel;
+	int		bvh_build;
+	int		light_cache;
+	int		shadows;
+	int		shadow_res;
+	double	shadow_bias;
+	int		sort_rays;
+	int		order;
+	int		bench_order;
+}			t_options;
+
+char		*parse_options(int argc, char **argv, t_options *opts);
+int			parse_value_flag(char *arg, char *value, t_options *opts);
+int			parse_order(char *value, t_options *opts);
+
+#endif
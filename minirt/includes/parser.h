@@ -119,5 +119,6 @@ void		free_tokens(char **tokens);
 
 /* Scene management functions */
 int			add_object_to_scene(t_scene *scene, int type, void *object_data);
+void		free_scene(t_scene *scene);
 
 #endif
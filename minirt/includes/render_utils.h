@@ -16,9 +16,13 @@ void		main_draw(t_vars *vars, t_scene *scene);
 
 /* Lighting utilities */
 t_color3	calculate_ambient(const t_scene *scene, const t_hit *hit);
-t_color3	calculate_diffuse(const t_scene *scene, const t_hit *hit);
+t_color3	calculate_diffuse(const t_scene *scene, const t_hit *hit, int lit);
+int			is_lit(const t_scene *scene, const t_hit *hit,
+				t_hints *hints);
 int			is_in_shadow(const t_scene *scene, const t_vec3 point,
-				const t_vec3 light_pos);
-t_color3	calculate_lighting(const t_scene *scene, const t_hit *hit);
+				int receiver, t_hints *hints);
+t_ray		shadow_ray(const t_vec3 point, const t_vec3 light_pos);
+t_color3	calculate_lighting(const t_scene *scene, const t_hit *hit,
+				int lit);
 
 #endif
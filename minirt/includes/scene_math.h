@@ -26,7 +26,7 @@ typedef t_vec3		t_color3;
 # define PLANE 2
 # define CYLINDER 3
 # define CONE 4
-# define MAX_OBJECTS 100
+# define OBJECT_CAPACITY 64
 
 typedef struct s_camera
 {
@@ -69,6 +69,16 @@ typedef struct s_plane
 	t_material		material;
 }					t_plane;
 
+/*
+** Sphere enclosing an object, cached when the object is added or edited
+** so rays that cannot reach it skip the full intersection kernel
+*/
+typedef struct s_bound_sphere
+{
+	t_point3		center;
+	double			radius_sq;
+}					t_bound_sphere;
+
 typedef struct s_cylinder
 {
 	t_point3		center;
@@ -77,6 +87,7 @@ typedef struct s_cylinder
 	double			height;
 	t_color3		color;
 	t_material		material;
+	t_bound_sphere	bound;
 }					t_cylinder;
 
 typedef struct s_cone
@@ -87,6 +98,7 @@ typedef struct s_cone
 	double			height;
 	t_color3		color;
 	t_material		material;
+	t_bound_sphere	bound;
 }					t_cone;
 
 typedef struct s_object
@@ -106,10 +118,12 @@ typedef struct s_scene
 	t_camera		camera;
 	t_ambient		ambient;
 	t_light			light;
-	t_object		objects[MAX_OBJECTS];
+	t_object		*objects;
 	int				num_objects;
+	int				max_objects;
 	int				has_ambient;
 	int				has_light;
+	struct s_accel	*accel;
 }					t_scene;
 
 // --- Matrix and transform types ---
@@ -127,12 +141,36 @@ typedef struct s_transform
 }					t_transform;
 
 // --- Ray type ---
+// Hits count only strictly inside (tmin, tmax); traversal lowers tmax
+// to the closest hit found so far
 typedef struct s_ray
 {
 	t_vec3			origin;
 	t_vec3			direction;
+	double			tmin;
+	double			tmax;
 }					t_ray;
 
+// --- Camera view basis, shared by ray generation and reprojection ---
+typedef struct s_view
+{
+	t_point3		origin;
+	t_vec3			right;
+	t_vec3			up;
+	t_vec3			forward;
+	double			pixel_scale;
+}					t_view;
+
+// --- Coherence hints, owned by one tracing caller ---
+// The object its last primary ray hit and its last shadow ray's occluder,
+// tested first by its next ray; -1 for none. Callers tracing
+// concurrently each need their own
+typedef struct s_hints
+{
+	int				primary;
+	int				occluder;
+}					t_hints;
+
 // --- Math/vector utilities ---
 t_vec3				vec3_create(double x, double y, double z);
 t_vec3				vec3_add(t_vec3 v1, t_vec3 v2);
@@ -147,7 +185,7 @@ double				vec3_length_squared(t_vec3 v);
 t_vec3				reflect(t_vec3 v, t_vec3 n);
 t_vec3				vec3_rotate_around_axis(t_vec3 v, t_vec3 axis,
 						double angle);
-double				solve_quadratic(double a, double b, double c, double min_t);
+double				solve_quadratic(t_quadratic q, double tmin, double tmax);
 
 // --- Matrix operations ---
 t_matrix4			matrix4_identity(void);
@@ -190,6 +228,11 @@ void				scene_rotate_camera(t_scene *scene, t_vec3 rotation);
 
 // --- Ray tracing functions ---
 t_ray				generate_camera_ray(const t_scene *scene, int x, int y);
-int					trace_ray(const t_scene *scene, t_ray ray);
+t_ray				generate_camera_ray_at(const t_scene *scene, double x,
+						double y);
+t_view				camera_view(const t_scene *scene);
+t_ray				view_ray(const t_view *view, double x, double y);
+int					trace_ray(const t_scene *scene, t_ray ray,
+						t_hints *hints);
 
 #endif
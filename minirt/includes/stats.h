@@ -0,0 +1,51 @@
+#ifndef STATS_H
+# define STATS_H
+
+/* Wavefront renderer stages, timed in stage_us */
+# define WAVE_GENERATE 0
+# define WAVE_INTERSECT 1
+# define WAVE_COMPACT 2
+# define WAVE_SHADOW 3
+# define WAVE_SHADE 4
+# define WAVE_STAGES 5
+
+/*
+** Per-frame render counters, reset by main_draw and printed with --stats
+** build_ms is the acceleration structure build time, kept across frames
+** packet_tests counts spheres tested against shadow packets, and
+** packet_solves those that let some lane through, with packet_lanes the
+** lanes they let through: the packets' coherence
+*/
+typedef struct s_render_stats
+{
+	long	build_ms;
+	long	frame_ms;
+	long	primary_rays;
+	long	shadow_rays;
+	long	aa_pixels;
+	long	aa_samples;
+	long	bound_tests;
+	long	bound_rejects;
+	long	shadow_tiles;
+	long	tile_casters;
+	long	shadow_packets;
+	long	packet_tests;
+	long	packet_solves;
+	long	packet_lanes;
+	long	primary_hints;
+	long	primary_hint_hits;
+	long	occluder_hints;
+	long	occluder_hint_hits;
+	long	light_cache_lookups;
+	long	light_cache_hits;
+	long	shadow_map_texels;
+	long	stage_us[WAVE_STAGES];
+}			t_render_stats;
+
+extern t_render_stats	g_stats;
+
+void		stats_reset(void);
+void		stats_print(void);
+void		stats_stage_end(int stage, long *start);
+
+#endif
@@ -0,0 +1,96 @@
+#ifndef WAVEFRONT_H
+# define WAVEFRONT_H
+
+# include "minirt_app.h"
+# include "accel.h"
+# include <stddef.h>
+
+/* Rays per wave: the pixels of one screen tile, or of a scanline run */
+# define WAVE_SIZE (TILE_SIZE * TILE_SIZE)
+
+/* Alignment of the arena's allocations (one AVX register) */
+# define ARENA_ALIGN 32
+
+/*
+** Bump allocator over one block owned by a tracing thread; everything
+** taken from it is released at once with the block
+*/
+typedef struct s_arena
+{
+	char			*base;
+	size_t			size;
+	size_t			used;
+}					t_arena;
+
+/* Sort key of a shadow ray and the pixel it was cast for */
+typedef struct s_ray_key
+{
+	unsigned long	key;
+	int				pixel;
+}					t_ray_key;
+
+/*
+** One wave of the wavefront renderer (a screen tile, or WAVE_SIZE pixels
+** of the scanline order) and its queues,
+** taken from the tracing thread's arena: the primary rays, from the
+** view's origin, as directions per axis with their pixels; the pixels
+** whose rays hit, compacted; and the shadow queue, in shadows.pixels:
+** the hits facing the light whose shadow state is not known yet
+** packets is set when the shadow queue is traced in packets against the
+** tile's culled casters, otherwise each entry goes through is_lit
+** With sort_rays, the shadow queue is sorted first, through keys (the
+** keys and a scratch buffer for the merge sort)
+** order is the frame's pixel order: wave i traces tile tile_order[i],
+** its pixels in pixel_order, for the tiled and curve orders; num_waves
+** waves cover the frame
+** hints are the wave's own, carried from wave to wave through the frame
+*/
+typedef struct s_wave
+{
+	t_view			view;
+	double			*dir[3];
+	int				*pixels;
+	int				num_rays;
+	int				*hits;
+	int				num_hits;
+	t_shadow_tile	shadows;
+	int				packets;
+	int				sort_rays;
+	t_ray_key		*keys[2];
+	int				order;
+	int				*tile_order;
+	int				*pixel_order;
+	int				num_waves;
+	t_hints			hints;
+}					t_wave;
+
+/*
+** Arena bytes for a wave's queues (20 KB) and its tile and pixel orders,
+** alignment padding included
+*/
+# define WAVE_ARENA_SIZE (20480 + 4 * (TILES_X * TILES_Y + 2 * WAVE_SIZE))
+
+/* Arena */
+void				arena_init(t_arena *arena, size_t size);
+void				*arena_take(t_arena *arena, size_t size);
+void				arena_free(t_arena *arena);
+
+/* Stages, run in this order on each wave */
+void				wave_generate(t_wave *wave, int index);
+void				wave_intersect(t_vars *vars, const t_scene *scene,
+						t_wave *wave);
+void				wave_compact(t_vars *vars, const t_scene *scene,
+						t_wave *wave);
+void				wave_shadow(t_vars *vars, const t_scene *scene,
+						t_wave *wave);
+void				wave_shade(t_vars *vars, const t_scene *scene,
+						const t_wave *wave);
+t_ray				wave_ray(const t_wave *wave, int i);
+void				wave_sort_shadows(const t_vars *vars,
+						const t_scene *scene, t_wave *wave);
+
+/* Pixel orders */
+void				wave_order_init(t_wave *wave, t_arena *arena, int order);
+int					wave_pixel(const t_wave *wave, int index, int i);
+
+#endif
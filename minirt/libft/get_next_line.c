@@ -55,6 +55,8 @@ char	*get_full_line(int fd, char *rbuf)
 	char	*buffer;
 	char	*tmp;
 
+	if (rbuf && ft_strchr(rbuf, '\n'))
+		return (rbuf);
 	buffer = ft_calloc((size_t)(BUFFER_SIZE + 1), 1);
 	if (!buffer)
 		return (ft_free((void **)&rbuf), NULL);
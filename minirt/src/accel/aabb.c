@@ -0,0 +1,78 @@
+#include "../../includes/minirt_app.h"
+#include "../../includes/accel.h"
+
+/*
+** Reciprocal that stays finite for axis-parallel rays
+** (-ffast-math assumes no infinities)
+*/
+static double	safe_inverse(double d)
+{
+	if (fabs(d) < 1e-12)
+	{
+		if (d < 0)
+			return (-1e12);
+		return (1e12);
+	}
+	return (1.0 / d);
+}
+
+/*
+** Per-ray reciprocal direction for slab tests
+*/
+t_vec3	ray_inverse_direction(t_ray ray)
+{
+	return (vec3_create(safe_inverse(ray.direction.x),
+			safe_inverse(ray.direction.y), safe_inverse(ray.direction.z)));
+}
+
+/*
+** Slab test for one axis, narrowing [tmin, tmax]
+*/
+static void	slab(double lo, double hi, double inv, double *range)
+{
+	double	t0;
+	double	t1;
+
+	t0 = lo * inv;
+	t1 = hi * inv;
+	if (inv < 0.0)
+	{
+		t0 = hi * inv;
+		t1 = lo * inv;
+	}
+	range[0] = fmax(range[0], t0);
+	range[1] = fmin(range[1], t1);
+}
+
+/*
+** Clip the ray against the box: range holds [0, tmax] on input and the
+** overlap interval on output. Returns 1 if the interval is not empty.
+** The box tests run per node, so the ray is passed by pointer
+*/
+int	aabb_clip(const t_aabb *box, const t_ray *ray, t_vec3 inv_dir,
+		double *range)
+{
+	slab(box->min.x - ray->origin.x, box->max.x - ray->origin.x,
+		inv_dir.x, range);
+	slab(box->min.y - ray->origin.y, box->max.y - ray->origin.y,
+		inv_dir.y, range);
+	slab(box->min.z - ray->origin.z, box->max.z - ray->origin.z,
+		inv_dir.z, range);
+	return (range[0] <= range[1]);
+}
+
+/*
+** Distance at which the ray enters the box within [0, tmax]
+** Returns -1 if the ray misses the box in that interval
+*/
+double	aabb_entry(const t_aabb *box, const t_ray *ray, t_vec3 inv_dir,
+		double tmax)
+{
+	double	range[2];
+
+	range[0] = 0.0;
+	range[1] = tmax;
+	if (!aabb_clip(box, ray, inv_dir, range))
+		return (-1.0);
+	return (range[0]);
+}
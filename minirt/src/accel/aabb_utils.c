@@ -0,0 +1,62 @@
+#include "../../includes/minirt_app.h"
+#include "../../includes/accel.h"
+
+/*
+** Inverted box that any union will replace
+*/
+t_aabb	aabb_empty(void)
+{
+	t_aabb	box;
+
+	box.min = vec3_create(DBL_MAX, DBL_MAX, DBL_MAX);
+	box.max = vec3_create(-DBL_MAX, -DBL_MAX, -DBL_MAX);
+	return (box);
+}
+
+/*
+** Smallest box containing both boxes
+*/
+t_aabb	aabb_union(t_aabb a, t_aabb b)
+{
+	a.min.x = fmin(a.min.x, b.min.x);
+	a.min.y = fmin(a.min.y, b.min.y);
+	a.min.z = fmin(a.min.z, b.min.z);
+	a.max.x = fmax(a.max.x, b.max.x);
+	a.max.y = fmax(a.max.y, b.max.y);
+	a.max.z = fmax(a.max.z, b.max.z);
+	return (a);
+}
+
+/*
+** Surface area of a box, the SAH probability weight
+*/
+double	aabb_area(const t_aabb *box)
+{
+	t_vec3	e;
+
+	if (box->min.x > box->max.x)
+		return (0.0);
+	e = vec3_sub(box->max, box->min);
+	return (2.0 * (e.x * e.y + e.y * e.z + e.z * e.x));
+}
+
+/*
+** Component of a vector along axis 0 (x), 1 (y) or 2 (z)
+*/
+double	vec3_component(t_vec3 v, int axis)
+{
+	if (axis == 0)
+		return (v.x);
+	if (axis == 1)
+		return (v.y);
+	return (v.z);
+}
+
+/*
+** Centre of a box along one axis
+*/
+double	aabb_centroid(const t_aabb *box, int axis)
+{
+	return (0.5 * (vec3_component(box->min, axis)
+			+ vec3_component(box->max, axis)));
+}
@@ -0,0 +1,138 @@
+#include "../../includes/minirt_app.h"
+#include "../../includes/accel.h"
+#include "../../includes/stats.h"
+
+/*
+** Allocate the plane list, bounds, view list, origin cache, light cone
+** and tile caster arrays, sized for all objects
+*/
+static void	accel_alloc(t_accel *accel, int n)
+{
+	accel->num_objects = n;
+	if (n < 1)
+		n = 1;
+	accel->planes.nx = malloc(sizeof(double) * n);
+	accel->planes.ny = malloc(sizeof(double) * n);
+	accel->planes.nz = malloc(sizeof(double) * n);
+	accel->planes.d = malloc(sizeof(double) * n);
+	accel->planes.index = malloc(sizeof(int) * n);
+	accel->bounds = malloc(sizeof(t_aabb) * n);
+	accel->bounded = malloc(sizeof(int) * n);
+	accel->view.items = malloc(sizeof(t_view_item) * n);
+	accel->view.scratch = malloc(sizeof(t_view_item) * n);
+	accel->camera.terms = malloc(sizeof(t_origin_terms) * n);
+	accel->light.terms = malloc(sizeof(t_origin_terms) * n);
+	accel->light_cones = malloc(sizeof(t_bound_cone) * n);
+	accel->tile_casters = malloc(sizeof(int) * n);
+	if (!accel->planes.nx || !accel->planes.ny || !accel->planes.nz
+		|| !accel->planes.d || !accel->planes.index || !accel->bounds
+		|| !accel->bounded || !accel->view.items || !accel->view.scratch
+		|| !accel->camera.terms || !accel->light.terms || !accel->light_cones
+		|| !accel->tile_casters)
+		error_exit(ERR_MEMORY);
+}
+
+/*
+** Collect the bounded objects with their boxes, then build the structure
+** selected by mode over them
+*/
+static void	accel_build_structure(t_accel *accel, const t_scene *scene)
+{
+	int	i;
+
+	accel->num_bounded = 0;
+	i = 0;
+	while (i < scene->num_objects)
+	{
+		if (object_bounds(&scene->objects[i], &accel->bounds[i]))
+			accel->bounded[accel->num_bounded++] = i;
+		i++;
+	}
+	if (accel->mode == ACCEL_BVH || accel->mode == ACCEL_WBVH
+		|| accel->mode == ACCEL_LAZY)
+		bvh_build(accel);
+	if (accel->mode == ACCEL_WBVH)
+		wbvh_build(accel);
+	if (accel->mode == ACCEL_GRID)
+		grid_build(accel);
+}
+
+/*
+** Split the scene into the plane list and the bounded objects,
+** then index the bounded objects with the selected structure
+** The build time is kept in the stats next to the frame times
+*/
+void	accel_build(t_scene *scene, const t_options *opts)
+{
+	t_accel	*accel;
+	long	start;
+
+	start = time_now_ms();
+	accel = ft_calloc(1, sizeof(t_accel));
+	if (!accel)
+		error_exit(ERR_MEMORY);
+	accel->mode = opts->accel;
+	light_cache_init(&accel->light_cache, opts->light_cache);
+	shadow_map_init(&accel->shadow_map, opts);
+	accel->build = opts->bvh_build;
+	accel->threads = cpu_count();
+	if (accel->threads > BVH_MAX_THREADS)
+		accel->threads = BVH_MAX_THREADS;
+	pthread_mutex_init(&accel->rebuild.lock, NULL);
+	pthread_mutex_init(&accel->lazy_lock, NULL);
+	accel_alloc(accel, scene->num_objects);
+	plane_list_build(&accel->planes, scene);
+	accel_build_structure(accel, scene);
+	scene->accel = accel;
+	g_stats.build_ms = time_now_ms() - start;
+}
+
+/*
+** Refresh the acceleration data after an object was edited, starting
+** with the object's own bounding sphere; the caster lists are rebuilt
+** before the next frame, the light cache drops what the edit may have
+** changed and the shadow map is traced again
+** The BVH refits the path above the object and is rebuilt in the
+** background once refits have degraded it, and the wide BVH is collapsed
+** again from it; the grid is rebuilt, which is linear in the number of
+** objects
+*/
+void	accel_update_object(t_scene *scene, int obj_index)
+{
+	t_accel	*accel;
+
+	if (obj_index < 0 || obj_index >= scene->num_objects)
+		return ;
+	object_update_bound(&scene->objects[obj_index]);
+	accel = scene->accel;
+	if (!accel)
+		return ;
+	accel->casters.valid = 0;
+	light_cache_invalidate(accel, scene, obj_index);
+	accel->shadow_map.valid = 0;
+	if (scene->objects[obj_index].type == PLANE)
+		return (plane_list_build(&accel->planes, scene));
+	object_bounds(&scene->objects[obj_index], &accel->bounds[obj_index]);
+	if (accel->mode == ACCEL_GRID)
+		grid_build(accel);
+	else if (accel->mode != ACCEL_NONE)
+	{
+		bvh_refit(&accel->bvh, accel->bounds, obj_index);
+		if (bvh_degraded(&accel->bvh))
+			bvh_start_rebuild(accel);
+		if (accel->mode == ACCEL_WBVH)
+			wbvh_build(accel);
+	}
+}
+
+/*
+** Install a finished background rebuild, if any; called before frames
+*/
+void	accel_poll(t_scene *scene)
+{
+	if (scene->accel && scene->accel->mode != ACCEL_NONE
+		&& scene->accel->mode != ACCEL_GRID
+		&& bvh_poll_rebuild(scene->accel)
+		&& scene->accel->mode == ACCEL_WBVH)
+		wbvh_build(scene->accel);
+}
@@ -0,0 +1,104 @@
+#include "../../includes/minirt_app.h"
+#include "../../includes/accel.h"
+
+/*
+** Allocate the BVH arrays on first build
+** A binary tree over n objects needs at most 2n - 1 nodes
+*/
+void	bvh_alloc(t_accel *accel)
+{
+	t_bvh	*bvh;
+
+	bvh = &accel->bvh;
+	if (bvh->nodes)
+		return ;
+	bvh->nodes = malloc(sizeof(t_bvh_node) * (2 * accel->num_bounded + 1));
+	bvh->parent = malloc(sizeof(int) * (2 * accel->num_bounded + 1));
+	bvh->prims = malloc(sizeof(int) * (accel->num_bounded + 1));
+	bvh->leaf_of = malloc(sizeof(int) * (accel->num_objects + 1));
+	bvh->codes = malloc(sizeof(unsigned int) * (accel->num_bounded + 1));
+	if (!bvh->nodes || !bvh->parent || !bvh->prims || !bvh->leaf_of
+		|| !bvh->codes)
+		error_exit(ERR_MEMORY);
+}
+
+/*
+** Release the acceleration data
+*/
+void	accel_free(t_scene *scene)
+{
+	if (!scene->accel)
+		return ;
+	plane_list_free(&scene->accel->planes);
+	free(scene->accel->bounds);
+	free(scene->accel->bounded);
+	free(scene->accel->view.items);
+	free(scene->accel->view.scratch);
+	free(scene->accel->tiles.tile_start);
+	free(scene->accel->tiles.tile_items);
+	free(scene->accel->camera.terms);
+	free(scene->accel->light.terms);
+	free(scene->accel->light_cones);
+	free(scene->accel->tile_casters);
+	caster_lists_free(&scene->accel->casters);
+	light_cache_free(&scene->accel->light_cache);
+	shadow_map_free(&scene->accel->shadow_map);
+	bvh_stop_rebuild(scene->accel);
+	pthread_mutex_destroy(&scene->accel->rebuild.lock);
+	pthread_mutex_destroy(&scene->accel->lazy_lock);
+	bvh_free(&scene->accel->bvh);
+	free(scene->accel->wbvh.nodes);
+	grid_free(&scene->accel->grid);
+	free(scene->accel);
+	scene->accel = NULL;
+}
+
+/*
+** Release the BVH arrays
+*/
+void	bvh_free(t_bvh *bvh)
+{
+	free(bvh->nodes);
+	free(bvh->parent);
+	free(bvh->prims);
+	free(bvh->leaf_of);
+	free(bvh->codes);
+	bvh->nodes = NULL;
+	bvh->parent = NULL;
+	bvh->prims = NULL;
+	bvh->leaf_of = NULL;
+	bvh->codes = NULL;
+	bvh->num_nodes = 0;
+	bvh->num_prims = 0;
+}
+
+/*
+** Release the grid cell arrays
+*/
+void	grid_free(t_grid *grid)
+{
+	free(grid->cell_start);
+	free(grid->cell_items);
+	grid->cell_start = NULL;
+	grid->cell_items = NULL;
+	grid->num_cells = 0;
+}
+
+/*
+** Wait for a pending background rebuild and drop its result
+*/
+void	bvh_stop_rebuild(t_accel *accel)
+{
+	t_accel	*snap;
+
+	if (!accel->rebuild.running)
+		return ;
+	pthread_join(accel->rebuild.thread, NULL);
+	accel->rebuild.running = FALSE;
+	snap = accel->rebuild.snapshot;
+	bvh_free(&snap->bvh);
+	free(snap->bounds);
+	free(snap->bounded);
+	free(snap);
+	accel->rebuild.snapshot = NULL;
+}
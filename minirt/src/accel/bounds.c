@@ -0,0 +1,86 @@
+#include "../../includes/minirt_app.h"
+#include "../../includes/accel.h"
+
+/*
+** Box around a disk of the given radius, centre and unit normal
+** The extent along axis i is radius * sqrt(1 - normal_i^2)
+*/
+static t_aabb	disk_bounds(t_point3 center, t_vec3 normal, double radius)
+{
+	t_vec3	e;
+	t_aabb	box;
+
+	e.x = radius * sqrt(fmax(0.0, 1.0 - normal.x * normal.x));
+	e.y = radius * sqrt(fmax(0.0, 1.0 - normal.y * normal.y));
+	e.z = radius * sqrt(fmax(0.0, 1.0 - normal.z * normal.z));
+	box.min = vec3_sub(center, e);
+	box.max = vec3_add(center, e);
+	return (box);
+}
+
+/*
+** Capped cylinder: union of its two cap disks
+*/
+static t_aabb	cylinder_bounds(const t_cylinder *cyl)
+{
+	double		radius;
+	t_point3	top;
+
+	radius = cyl->diameter / 2.0;
+	top = vec3_add(cyl->center, vec3_mult(cyl->axis, cyl->height));
+	return (aabb_union(disk_bounds(cyl->center, cyl->axis, radius),
+			disk_bounds(top, cyl->axis, radius)));
+}
+
+/*
+** Cone: union of its apex and its base disk
+*/
+static t_aabb	cone_bounds(const t_cone *cone)
+{
+	t_aabb		apex;
+	t_point3	base;
+
+	apex.min = cone->vertex;
+	apex.max = cone->vertex;
+	base = vec3_add(cone->vertex, vec3_mult(cone->axis, cone->height));
+	return (aabb_union(apex, disk_bounds(base, cone->axis,
+				cone->height * tan(cone->angle / 2.0))));
+}
+
+/*
+** Compute the bounding box of an object, padded by EPSILON so rays
+** grazing a face (e.g. level with a cap) still reach the object's kernel
+** Returns 0 for unbounded objects (planes)
+*/
+int	object_bounds(const t_object *obj, t_aabb *box)
+{
+	t_vec3	r;
+
+	if (obj->type == SPHERE)
+	{
+		r = vec3_create(obj->data.sphere.diameter / 2.0,
+				obj->data.sphere.diameter / 2.0,
+				obj->data.sphere.diameter / 2.0);
+		box->min = vec3_sub(obj->data.sphere.center, r);
+		box->max = vec3_add(obj->data.sphere.center, r);
+	}
+	else if (obj->type == CYLINDER)
+		*box = cylinder_bounds(&obj->data.cylinder);
+	else if (obj->type == CONE)
+		*box = cone_bounds(&obj->data.cone);
+	else
+		return (0);
+	r = vec3_create(EPSILON, EPSILON, EPSILON);
+	box->min = vec3_sub(box->min, r);
+	box->max = vec3_add(box->max, r);
+	return (1);
+}
+
+/*
+** Check whether the ray overlaps the box within [0, tmax]
+*/
+int	aabb_hit(const t_aabb *box, const t_ray *ray, t_vec3 inv_dir,
+		double tmax)
+{
+	return (aabb_entry(box, ray, inv_dir, tmax) >= 0.0);
+}
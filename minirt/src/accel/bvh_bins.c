@@ -0,0 +1,92 @@
+#include "../../includes/minirt_app.h"
+#include "../../includes/accel.h"
+
+/*
+** Bin of a centroid coordinate along an axis binned from lo with scale
+*/
+int	bvh_bin_index(double centroid, double lo, double scale)
+{
+	int	bin;
+
+	bin = (int)((centroid - lo) * scale);
+	if (bin < 0)
+		bin = 0;
+	if (bin >= BVH_BINS)
+		bin = BVH_BINS - 1;
+	return (bin);
+}
+
+/*
+** Bounds of the object centroids, which the bins subdivide
+*/
+t_aabb	bvh_centroid_bounds(const t_accel *accel, const int *prims, int count)
+{
+	t_aabb	centroids;
+	t_aabb	point;
+	int		i;
+
+	centroids = aabb_empty();
+	i = -1;
+	while (++i < count)
+	{
+		point.min = vec3_mult(vec3_add(accel->bounds[prims[i]].min,
+					accel->bounds[prims[i]].max), 0.5);
+		point.max = point.min;
+		centroids = aabb_union(centroids, point);
+	}
+	return (centroids);
+}
+
+/*
+** Spread BVH_BINS bins over the centroid bounds on every axis, all empty
+** Axes too thin to split get a zero scale and are skipped
+*/
+void	bvh_binning_init(t_binning *binning, t_aabb centroids)
+{
+	double	extent;
+	int		axis;
+	int		i;
+
+	axis = -1;
+	while (++axis < 3)
+	{
+		binning->lo[axis] = vec3_component(centroids.min, axis);
+		extent = vec3_component(centroids.max, axis) - binning->lo[axis];
+		binning->scale[axis] = 0.0;
+		if (extent > EPSILON)
+			binning->scale[axis] = BVH_BINS / extent;
+		i = -1;
+		while (++i < BVH_BINS)
+		{
+			binning->bins[axis][i].box = aabb_empty();
+			binning->bins[axis][i].count = 0;
+		}
+	}
+}
+
+/*
+** Add objects to the bins of every splittable axis
+*/
+void	bvh_bin_range(const t_accel *accel, const int *prims, int count,
+		t_binning *binning)
+{
+	t_bin	*bin;
+	int		axis;
+	int		i;
+
+	i = -1;
+	while (++i < count)
+	{
+		axis = -1;
+		while (++axis < 3)
+		{
+			if (binning->scale[axis] == 0.0)
+				continue ;
+			bin = &binning->bins[axis][bvh_bin_index(
+					aabb_centroid(&accel->bounds[prims[i]], axis),
+					binning->lo[axis], binning->scale[axis])];
+			bin->box = aabb_union(bin->box, accel->bounds[prims[i]]);
+			bin->count++;
+		}
+	}
+}
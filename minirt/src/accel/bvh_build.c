@@ -0,0 +1,148 @@
+#include "../../includes/minirt_app.h"
+#include "../../includes/accel.h"
+
+/*
+** Set up a fresh node over prims[first, first + count); it stays pending
+** until bvh_build_node makes it a leaf or splits it
+*/
+static void	init_node(t_accel *accel, int node, int first, int count)
+{
+	t_aabb	box;
+	int		i;
+
+	box = aabb_empty();
+	i = 0;
+	while (i < count)
+	{
+		box = aabb_union(box, accel->bounds[accel->bvh.prims[first + i]]);
+		i++;
+	}
+	accel->bvh.nodes[node].box = box;
+	accel->bvh.nodes[node].first = first;
+	accel->bvh.nodes[node].count = count;
+	accel->bvh.nodes[node].left = BVH_PENDING;
+}
+
+/*
+** Choose how to split the range of a fresh node: at the cheapest SAH bin
+** boundary, or at the highest differing Morton bit for LBVH builds
+** Ranges that cannot be split stay leaves unless they are too large,
+** in which case they are halved in place, as are all ranges from
+** BVH_BALANCE_DEPTH on, so the tree fits the traversal stack
+** Returns the number of objects going left, 0 to keep a leaf, -1 to leave
+** the node pending (lazy trees, at the task's lazy_depth)
+*/
+static int	split_count(t_build_task *task)
+{
+	t_prim_range	range;
+	t_split			split;
+	int				left_count;
+
+	if (task->accel->mode == ACCEL_LAZY && task->depth >= task->lazy_depth)
+		return (-1);
+	range.box = task->accel->bvh.nodes[task->node].box;
+	range.prims = task->accel->bvh.prims + task->first;
+	range.count = task->count;
+	if (range.count <= BVH_LEAF_SIZE)
+		return (0);
+	if (task->depth >= BVH_BALANCE_DEPTH)
+		return (range.count / 2);
+	left_count = 0;
+	if (task->accel->build == BVH_BUILD_LBVH)
+		left_count = bvh_morton_split(&task->accel->bvh, task->first,
+				range.count);
+	else if (bvh_find_split(task->accel, &range, &split))
+		left_count = bvh_partition(task->accel, &range, &split);
+	if (left_count == 0 && range.count > BVH_MAX_LEAF)
+		return (range.count / 2);
+	return (left_count);
+}
+
+/*
+** Set up the two child tasks of a split and their nodes; the child pair
+** is claimed atomically, so subtrees can be built by several threads
+*/
+static void	make_children(t_build_task *task, int left_count,
+		t_build_task *child)
+{
+	t_bvh	*bvh;
+
+	bvh = &task->accel->bvh;
+	child[0] = *task;
+	child[0].node = __atomic_fetch_add(&bvh->num_nodes, 2, __ATOMIC_RELAXED);
+	child[0].count = left_count;
+	child[0].depth = task->depth + 1;
+	child[1] = child[0];
+	child[1].node++;
+	child[1].first += left_count;
+	child[1].count = task->count - left_count;
+	init_node(task->accel, child[0].node, child[0].first, child[0].count);
+	init_node(task->accel, child[1].node, child[1].first, child[1].count);
+	bvh->parent[child[0].node] = task->node;
+	bvh->parent[child[1].node] = task->node;
+}
+
+/*
+** Build the subtree of a pending node, recording parents and the leaf of
+** every object for refits; lazy trees leave nodes at BVH_LAZY_DEPTH
+** pending, owning their objects like leaves until a ray reaches them
+** The node's left is published last, with release ordering, so a
+** concurrent lazy traversal never sees a half-built split
+*/
+void	bvh_build_node(t_build_task *task)
+{
+	t_bvh			*bvh;
+	t_build_task	child[2];
+	int				left_count;
+	int				i;
+
+	bvh = &task->accel->bvh;
+	left_count = split_count(task);
+	if (left_count <= 0)
+	{
+		i = -1;
+		while (++i < task->count)
+			bvh->leaf_of[bvh->prims[task->first + i]] = task->node;
+		if (left_count == 0)
+			__atomic_store_n(&bvh->nodes[task->node].left, 0, __ATOMIC_RELEASE);
+		return ;
+	}
+	make_children(task, left_count, child);
+	bvh_build_children(&child[0], &child[1]);
+	bvh->nodes[task->node].count = 0;
+	__atomic_store_n(&bvh->nodes[task->node].left, child[0].node,
+		__ATOMIC_RELEASE);
+}
+
+/*
+** Build the BVH over the bounded objects with the selected builder
+** and record its cost as the reference for later refits
+*/
+void	bvh_build(t_accel *accel)
+{
+	t_build_task	root;
+	int				i;
+
+	bvh_alloc(accel);
+	accel->bvh.num_prims = accel->num_bounded;
+	i = -1;
+	while (++i < accel->num_objects)
+		accel->bvh.leaf_of[i] = -1;
+	i = -1;
+	while (++i < accel->num_bounded)
+		accel->bvh.prims[i] = accel->bounded[i];
+	if (accel->build == BVH_BUILD_LBVH)
+		bvh_morton_sort(accel);
+	accel->bvh.num_nodes = 1;
+	accel->bvh.parent[0] = -1;
+	init_node(accel, 0, 0, accel->num_bounded);
+	root.accel = accel;
+	root.node = 0;
+	root.first = 0;
+	root.count = accel->num_bounded;
+	root.depth = 0;
+	root.lazy_depth = BVH_LAZY_DEPTH;
+	bvh_build_node(&root);
+	bvh_refit_all(&accel->bvh, accel->bounds);
+	accel->bvh.build_cost = accel->bvh.cost;
+}
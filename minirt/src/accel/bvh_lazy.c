@@ -0,0 +1,79 @@
+#include "../../includes/minirt_app.h"
+#include "../../includes/accel.h"
+
+/*
+** Depth of a node in the tree, counted up its parents
+*/
+static int	node_depth(const t_bvh *bvh, int node)
+{
+	int	depth;
+
+	depth = 0;
+	while (bvh->parent[node] >= 0)
+	{
+		node = bvh->parent[node];
+		depth++;
+	}
+	return (depth);
+}
+
+/*
+** Account for the split of a pending node that held count objects: its
+** leaf weight in the SAH cost gives way to its interior weight and its
+** fresh children's (as weighed by bvh_refit), in both the current and
+** the build cost, so bvh_degraded keeps measuring only what refits added
+*/
+static void	cost_expanded(t_bvh *bvh, int node, int count)
+{
+	const t_bvh_node	*n;
+	double				delta;
+
+	n = &bvh->nodes[node];
+	if (n->count > 0)
+		return ;
+	delta = aabb_area(&n->box) * (BVH_TRAVERSAL_COST - count)
+		+ aabb_area(&bvh->nodes[n->left].box) * bvh->nodes[n->left].count
+		+ aabb_area(&bvh->nodes[n->left + 1].box)
+		* bvh->nodes[n->left + 1].count;
+	bvh->cost += delta;
+	bvh->build_cost += delta;
+}
+
+/*
+** Split a pending node one level, its children left pending, unless
+** another thread did so while this one waited for the lock; the node's
+** depth comes from its parents, for the builder's depth limit, and the
+** tree's SAH costs follow the split
+*/
+static void	expand_node(t_accel *accel, int node)
+{
+	t_build_task	task;
+
+	pthread_mutex_lock(&accel->lazy_lock);
+	if (__atomic_load_n(&accel->bvh.nodes[node].left, __ATOMIC_ACQUIRE)
+		== BVH_PENDING)
+	{
+		task.accel = accel;
+		task.node = node;
+		task.first = accel->bvh.nodes[node].first;
+		task.count = accel->bvh.nodes[node].count;
+		task.depth = node_depth(&accel->bvh, node);
+		task.lazy_depth = task.depth + 1;
+		bvh_build_node(&task);
+		cost_expanded(&accel->bvh, node, task.count);
+	}
+	pthread_mutex_unlock(&accel->lazy_lock);
+}
+
+/*
+** Prepare a node reached by a ray: pending nodes of lazy trees are split
+** first, so parts of the scene no ray reaches are never built
+** Returns 1 if the node is a leaf, 0 if it has children
+*/
+int	bvh_visit(t_accel *accel, int node)
+{
+	if (__atomic_load_n(&accel->bvh.nodes[node].left, __ATOMIC_ACQUIRE)
+		== BVH_PENDING)
+		expand_node(accel, node);
+	return (accel->bvh.nodes[node].count > 0);
+}
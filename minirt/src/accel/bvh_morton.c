@@ -0,0 +1,136 @@
+#include "../../includes/minirt_app.h"
+#include "../../includes/accel.h"
+
+/*
+** Spread the low 10 bits of v so two zero bits separate each of them,
+** ready to be interleaved with two other axes
+*/
+unsigned int	morton_expand(unsigned int v)
+{
+	v = (v * 0x00010001u) & 0xFF0000FFu;
+	v = (v * 0x00000101u) & 0x0F00F00Fu;
+	v = (v * 0x00000011u) & 0xC30C30C3u;
+	v = (v * 0x00000005u) & 0x49249249u;
+	return (v);
+}
+
+/*
+** Morton code of a box centre: each axis of the centroid bounds is cut
+** into 2^MORTON_BITS cells and the cell coordinates are interleaved
+*/
+static unsigned int	morton_code(const t_aabb *box, const t_aabb *centroids)
+{
+	unsigned int	cell[3];
+	double			extent;
+	double			c;
+	int				axis;
+
+	axis = -1;
+	while (++axis < 3)
+	{
+		extent = vec3_component(centroids->max, axis)
+			- vec3_component(centroids->min, axis);
+		c = 0.0;
+		if (extent > 0.0)
+			c = (aabb_centroid(box, axis)
+					- vec3_component(centroids->min, axis)) / extent;
+		cell[axis] = (unsigned int)(c * ((1u << MORTON_BITS) - 1));
+	}
+	return (morton_expand(cell[0]) << 2 | morton_expand(cell[1]) << 1
+		| morton_expand(cell[2]));
+}
+
+/*
+** One stable counting-sort pass on MORTON_BITS bits of the codes, from
+** buffer pass % 2 into the other one
+*/
+static void	radix_pass(t_morton_sort *sort, int pass)
+{
+	int				count[(1 << MORTON_BITS) + 1];
+	unsigned int	digit;
+	int				from;
+	int				i;
+
+	from = pass % 2;
+	ft_bzero(count, sizeof(count));
+	i = -1;
+	while (++i < sort->count)
+		count[((sort->codes[from][i] >> (pass * MORTON_BITS))
+				& ((1u << MORTON_BITS) - 1)) + 1]++;
+	i = 0;
+	while (++i <= (1 << MORTON_BITS))
+		count[i] += count[i - 1];
+	i = -1;
+	while (++i < sort->count)
+	{
+		digit = (sort->codes[from][i] >> (pass * MORTON_BITS))
+			& ((1u << MORTON_BITS) - 1);
+		sort->codes[1 - from][count[digit]] = sort->codes[from][i];
+		sort->prims[1 - from][count[digit]++] = sort->prims[from][i];
+	}
+}
+
+/*
+** Order bvh.prims along the Morton curve, keeping their codes in bvh.codes
+** Three radix passes end in buffer 1, which is the BVH's own arrays
+*/
+void	bvh_morton_sort(t_accel *accel)
+{
+	t_morton_sort	sort;
+	t_aabb			centroids;
+	int				i;
+
+	sort.count = accel->num_bounded;
+	sort.codes[0] = malloc(sizeof(unsigned int) * (sort.count + 1));
+	sort.prims[0] = malloc(sizeof(int) * (sort.count + 1));
+	if (!sort.codes[0] || !sort.prims[0])
+		error_exit(ERR_MEMORY);
+	sort.codes[1] = accel->bvh.codes;
+	sort.prims[1] = accel->bvh.prims;
+	centroids = bvh_centroid_bounds(accel, accel->bvh.prims, sort.count);
+	i = -1;
+	while (++i < sort.count)
+	{
+		sort.prims[0][i] = accel->bvh.prims[i];
+		sort.codes[0][i] = morton_code(&accel->bounds[sort.prims[0][i]],
+				&centroids);
+	}
+	i = -1;
+	while (++i < 3)
+		radix_pass(&sort, i);
+	free(sort.codes[0]);
+	free(sort.prims[0]);
+}
+
+/*
+** LBVH split of a sorted range: the codes share every bit above the
+** highest one that differs between its ends, so the split goes where
+** that bit turns to 1, found by binary search
+** Returns the number of objects going left, 0 if all codes are equal
+*/
+int	bvh_morton_split(const t_bvh *bvh, int first, int count)
+{
+	unsigned int	diff;
+	int				bit;
+	int				lo;
+	int				hi;
+	int				mid;
+
+	diff = bvh->codes[first] ^ bvh->codes[first + count - 1];
+	if (diff == 0)
+		return (0);
+	bit = 31;
+	while (!((diff >> bit) & 1u))
+		bit--;
+	lo = first;
+	hi = first + count - 1;
+	while (lo + 1 < hi)
+	{
+		mid = lo + (hi - lo) / 2;
+		if ((bvh->codes[mid] >> bit) & 1u)
+			hi = mid;
+		else
+			lo = mid;
+	}
+	return (hi - first);
+}
@@ -0,0 +1,99 @@
+#include "../../includes/minirt_app.h"
+#include "../../includes/accel.h"
+
+/*
+** Thread body: bin one share of the range into the job's own bins
+*/
+static void	*bin_worker(void *arg)
+{
+	t_bin_job	*job;
+
+	job = arg;
+	bvh_bin_range(job->accel, job->prims, job->count, &job->binning);
+	return (NULL);
+}
+
+/*
+** Add the bins of one share into the totals
+*/
+static void	merge_bins(t_binning *into, const t_binning *from)
+{
+	int	axis;
+	int	i;
+
+	axis = -1;
+	while (++axis < 3)
+	{
+		i = -1;
+		while (++i < BVH_BINS)
+		{
+			into->bins[axis][i].box = aabb_union(into->bins[axis][i].box,
+					from->bins[axis][i].box);
+			into->bins[axis][i].count += from->bins[axis][i].count;
+		}
+	}
+}
+
+/*
+** Bin a large range with one thread per share, then merge the bins
+** Shares whose thread cannot be started are binned by the caller
+*/
+void	bvh_bin_parallel(const t_accel *accel, const t_prim_range *range,
+		t_binning *binning)
+{
+	t_bin_job	jobs[BVH_MAX_THREADS];
+	pthread_t	threads[BVH_MAX_THREADS];
+	int			started[BVH_MAX_THREADS];
+	long		n;
+	int			i;
+
+	n = range->count;
+	i = -1;
+	while (++i < accel->threads)
+	{
+		jobs[i].accel = accel;
+		jobs[i].prims = range->prims + n * i / accel->threads;
+		jobs[i].count = n * (i + 1) / accel->threads - n * i / accel->threads;
+		jobs[i].binning = *binning;
+		started[i] = (pthread_create(&threads[i], NULL, bin_worker,
+					&jobs[i]) == 0);
+	}
+	while (--i >= 0)
+	{
+		if (started[i])
+			pthread_join(threads[i], NULL);
+		else
+			bin_worker(&jobs[i]);
+		merge_bins(binning, &jobs[i].binning);
+	}
+}
+
+/*
+** Thread body: build one subtree
+*/
+static void	*build_worker(void *arg)
+{
+	bvh_build_node(arg);
+	return (NULL);
+}
+
+/*
+** Build both subtrees of a split; near the top of a large tree the left
+** one gets its own thread, until there is about one subtree per thread
+*/
+void	bvh_build_children(t_build_task *left, t_build_task *right)
+{
+	pthread_t	thread;
+
+	if (left->count + right->count >= BVH_PARALLEL_TASK_MIN
+		&& left->depth < BVH_MAX_THREADS
+		&& (1 << left->depth) <= left->accel->threads
+		&& pthread_create(&thread, NULL, build_worker, left) == 0)
+	{
+		bvh_build_node(right);
+		pthread_join(thread, NULL);
+		return ;
+	}
+	bvh_build_node(left);
+	bvh_build_node(right);
+}
@@ -0,0 +1,102 @@
+#include "../../includes/minirt_app.h"
+#include "../../includes/accel.h"
+
+/*
+** Thread body: build the snapshot's tree, then flag it as ready
+*/
+static void	*rebuild_thread(void *arg)
+{
+	t_accel	*accel;
+
+	accel = arg;
+	bvh_build(accel->rebuild.snapshot);
+	pthread_mutex_lock(&accel->rebuild.lock);
+	accel->rebuild.done = TRUE;
+	pthread_mutex_unlock(&accel->rebuild.lock);
+	return (NULL);
+}
+
+/*
+** Copy the bounds the rebuild works from, so later edits do not race it
+*/
+static t_accel	*snapshot_create(const t_accel *accel)
+{
+	t_accel	*snap;
+
+	snap = ft_calloc(1, sizeof(t_accel));
+	if (!snap)
+		error_exit(ERR_MEMORY);
+	snap->mode = accel->mode;
+	snap->build = accel->build;
+	snap->threads = accel->threads;
+	snap->num_objects = accel->num_objects;
+	snap->num_bounded = accel->num_bounded;
+	snap->bounds = malloc(sizeof(t_aabb) * (accel->num_objects + 1));
+	snap->bounded = malloc(sizeof(int) * (accel->num_bounded + 1));
+	if (!snap->bounds || !snap->bounded)
+		error_exit(ERR_MEMORY);
+	ft_memcpy(snap->bounds, accel->bounds,
+		sizeof(t_aabb) * accel->num_objects);
+	ft_memcpy(snap->bounded, accel->bounded, sizeof(int) * accel->num_bounded);
+	return (snap);
+}
+
+/*
+** Replace the current tree with the snapshot's one
+** Objects edited since the snapshot are caught up by a full refit
+*/
+static void	adopt_snapshot(t_accel *accel)
+{
+	t_accel	*snap;
+
+	snap = accel->rebuild.snapshot;
+	bvh_free(&accel->bvh);
+	accel->bvh = snap->bvh;
+	free(snap->bounds);
+	free(snap->bounded);
+	free(snap);
+	accel->rebuild.snapshot = NULL;
+	bvh_refit_all(&accel->bvh, accel->bounds);
+}
+
+/*
+** Start rebuilding the BVH in the background from a copy of the bounds,
+** so edits and rendering go on with the refitted tree meanwhile
+** If no thread can be started the rebuild runs here instead
+*/
+void	bvh_start_rebuild(t_accel *accel)
+{
+	if (accel->rebuild.running)
+		return ;
+	accel->rebuild.snapshot = snapshot_create(accel);
+	accel->rebuild.done = FALSE;
+	accel->rebuild.running = TRUE;
+	if (pthread_create(&accel->rebuild.thread, NULL, rebuild_thread,
+			accel) != 0)
+	{
+		accel->rebuild.running = FALSE;
+		bvh_build(accel->rebuild.snapshot);
+		adopt_snapshot(accel);
+	}
+}
+
+/*
+** Swap in the rebuilt tree once the thread is done
+** Returns 1 if a new tree was installed
+*/
+int	bvh_poll_rebuild(t_accel *accel)
+{
+	int	done;
+
+	if (!accel->rebuild.running)
+		return (0);
+	pthread_mutex_lock(&accel->rebuild.lock);
+	done = accel->rebuild.done;
+	pthread_mutex_unlock(&accel->rebuild.lock);
+	if (!done)
+		return (0);
+	pthread_join(accel->rebuild.thread, NULL);
+	accel->rebuild.running = FALSE;
+	adopt_snapshot(accel);
+	return (1);
+}
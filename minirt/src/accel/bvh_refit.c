@@ -0,0 +1,89 @@
+#include "../../includes/minirt_app.h"
+#include "../../includes/accel.h"
+
+/*
+** SAH weight of one node: its area times the cost of entering it,
+** one traversal step for interior nodes, one test per object for leaves
+*/
+static double	node_weight(const t_bvh *bvh, int node)
+{
+	if (bvh->nodes[node].count > 0)
+		return (aabb_area(&bvh->nodes[node].box) * bvh->nodes[node].count);
+	return (aabb_area(&bvh->nodes[node].box) * BVH_TRAVERSAL_COST);
+}
+
+/*
+** Recompute a node's box from its objects (leaf) or its children
+*/
+static void	refit_node(t_bvh *bvh, const t_aabb *bounds, int node)
+{
+	t_bvh_node	*n;
+	int			i;
+
+	n = &bvh->nodes[node];
+	if (n->count == 0)
+	{
+		n->box = aabb_union(bvh->nodes[n->left].box,
+				bvh->nodes[n->left + 1].box);
+		return ;
+	}
+	n->box = aabb_empty();
+	i = 0;
+	while (i < n->count)
+	{
+		n->box = aabb_union(n->box, bounds[bvh->prims[n->first + i]]);
+		i++;
+	}
+}
+
+/*
+** Refit the path from the leaf holding obj to the root after its bounds
+** changed; the topology is kept, the SAH cost is updated along the way
+*/
+void	bvh_refit(t_bvh *bvh, const t_aabb *bounds, int obj)
+{
+	int	node;
+
+	if (!bvh->nodes || obj < 0 || bvh->leaf_of[obj] < 0)
+		return ;
+	node = bvh->leaf_of[obj];
+	while (node >= 0)
+	{
+		bvh->cost -= node_weight(bvh, node);
+		refit_node(bvh, bounds, node);
+		bvh->cost += node_weight(bvh, node);
+		node = bvh->parent[node];
+	}
+}
+
+/*
+** Refit every node, children before parents (children are always
+** allocated after their parent, so reverse index order is bottom-up),
+** and recompute the SAH cost from scratch
+*/
+void	bvh_refit_all(t_bvh *bvh, const t_aabb *bounds)
+{
+	int	node;
+
+	bvh->cost = 0.0;
+	if (!bvh->nodes || bvh->num_prims == 0)
+		return ;
+	node = bvh->num_nodes;
+	while (--node >= 0)
+	{
+		refit_node(bvh, bounds, node);
+		bvh->cost += node_weight(bvh, node);
+	}
+}
+
+/*
+** Check whether refits made the tree notably worse than when it was built
+** Boxes inflated by moved objects raise the summed SAH cost, while the
+** topology stays tuned to the old positions
+*/
+int	bvh_degraded(const t_bvh *bvh)
+{
+	if (!bvh->nodes || bvh->num_prims == 0)
+		return (0);
+	return (bvh->cost > bvh->build_cost * BVH_REBUILD_RATIO);
+}
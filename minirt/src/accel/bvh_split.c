@@ -0,0 +1,114 @@
+#include "../../includes/minirt_app.h"
+#include "../../includes/accel.h"
+
+/*
+** Accumulate the boxes and counts to the right of each bin boundary
+*/
+static void	accumulate_right(const t_bin *bins, double *right_area,
+		int *right_count)
+{
+	t_aabb	acc;
+	int		count;
+	int		i;
+
+	acc = aabb_empty();
+	count = 0;
+	i = BVH_BINS;
+	while (--i > 0)
+	{
+		acc = aabb_union(acc, bins[i].box);
+		count += bins[i].count;
+		right_area[i - 1] = aabb_area(&acc);
+		right_count[i - 1] = count;
+	}
+}
+
+/*
+** Sweep the bin boundaries of one axis and keep the cheapest split
+** Right-hand areas and counts are accumulated first, then the left side
+*/
+static void	sweep_axis(const t_bin *bins, const t_prim_range *range,
+		t_split *split, t_split *best)
+{
+	double	right_area[BVH_BINS];
+	int		right_count[BVH_BINS];
+	t_aabb	acc;
+	int		count;
+	int		i;
+
+	accumulate_right(bins, right_area, right_count);
+	acc = aabb_empty();
+	count = 0;
+	i = 0;
+	while (++i < BVH_BINS)
+	{
+		acc = aabb_union(acc, bins[i - 1].box);
+		count += bins[i - 1].count;
+		split->cost = BVH_TRAVERSAL_COST + (aabb_area(&acc) * count
+				+ right_area[i - 1] * right_count[i - 1])
+			/ aabb_area(&range->box);
+		split->bin = i - 1;
+		if (count > 0 && right_count[i - 1] > 0 && split->cost < best->cost)
+			*best = *split;
+	}
+}
+
+/*
+** Binned SAH: try BVH_BINS - 1 planes along each axis of the centroid
+** bounds; large ranges are binned by several threads
+** Returns 1 if the best split is cheaper than keeping the range as a leaf
+*/
+int	bvh_find_split(const t_accel *accel, const t_prim_range *range,
+		t_split *best)
+{
+	t_binning	binning;
+	t_split		split;
+
+	best->cost = range->count;
+	if (aabb_area(&range->box) <= 0.0)
+		return (0);
+	bvh_binning_init(&binning, bvh_centroid_bounds(accel, range->prims,
+			range->count));
+	if (range->count >= BVH_PARALLEL_BIN_MIN && accel->threads > 1)
+		bvh_bin_parallel(accel, range, &binning);
+	else
+		bvh_bin_range(accel, range->prims, range->count, &binning);
+	split.axis = -1;
+	while (++split.axis < 3)
+	{
+		if (binning.scale[split.axis] == 0.0)
+			continue ;
+		split.lo = binning.lo[split.axis];
+		split.scale = binning.scale[split.axis];
+		sweep_axis(binning.bins[split.axis], range, &split, best);
+	}
+	return (best->cost < range->count);
+}
+
+/*
+** Move the objects left of the split to the front of the range
+** Returns the number of objects on the left
+*/
+int	bvh_partition(const t_accel *accel, t_prim_range *range,
+		const t_split *split)
+{
+	int	left;
+	int	right;
+	int	tmp;
+
+	left = 0;
+	right = range->count - 1;
+	while (left <= right)
+	{
+		if (bvh_bin_index(aabb_centroid(&accel->bounds[range->prims[left]],
+					split->axis), split->lo, split->scale) <= split->bin)
+			left++;
+		else
+		{
+			tmp = range->prims[left];
+			range->prims[left] = range->prims[right];
+			range->prims[right--] = tmp;
+		}
+	}
+	return (left);
+}
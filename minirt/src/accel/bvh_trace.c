@@ -0,0 +1,101 @@
+#include "../../includes/minirt_app.h"
+#include "../../includes/accel.h"
+
+/*
+** Test every object of a leaf (also used for wide BVH leaves)
+** Returns 1 if any hit, 0 if no hit
+*/
+int	bvh_trace_leaf(const t_scene *scene, const t_bvh_node *leaf,
+		t_ray ray, t_hit *closest_hit)
+{
+	int	hit_found;
+	int	prim;
+	int	i;
+
+	hit_found = 0;
+	i = 0;
+	while (i < leaf->count)
+	{
+		prim = scene->accel->bvh.prims[leaf->first + i];
+		if (trace_object(scene, ray, closest_hit, prim))
+			hit_found = 1;
+		i++;
+	}
+	return (hit_found);
+}
+
+/*
+** Push a node if the ray enters it before tmax; the builder keeps the
+** tree shallow enough for the stack, so overflowing it is a bug
+*/
+static void	push_node(t_bvh_stack *stack, int node, double entry)
+{
+	if (entry < 0.0)
+		return ;
+	if (stack->size >= BVH_STACK_SIZE)
+		error_exit(ERR_BVH_STACK);
+	stack->node[stack->size] = node;
+	stack->entry[stack->size] = entry;
+	stack->size++;
+}
+
+/*
+** Push the children the ray enters before tmax, far child first, so the
+** near child is popped next and its hit can cull the far one
+*/
+static void	push_children(const t_bvh *bvh, int node, t_ray ray,
+		t_bvh_stack *stack)
+{
+	double	t_left;
+	double	t_right;
+	int		left;
+
+	left = bvh->nodes[node].left;
+	t_left = aabb_entry(&bvh->nodes[left].box, &ray, stack->inv_dir,
+			stack->tmax);
+	t_right = aabb_entry(&bvh->nodes[left + 1].box, &ray, stack->inv_dir,
+			stack->tmax);
+	if (t_right >= 0.0 && t_right < t_left)
+	{
+		push_node(stack, left, t_left);
+		push_node(stack, left + 1, t_right);
+	}
+	else
+	{
+		push_node(stack, left + 1, t_right);
+		push_node(stack, left, t_left);
+	}
+}
+
+/*
+** Walk the BVH front to back with an explicit stack; nodes whose entry
+** lies beyond the closest hit found since they were pushed are skipped
+** Returns 1 if any hit, 0 if no hit
+*/
+int	bvh_trace(const t_scene *scene, t_ray ray, t_hit *closest_hit)
+{
+	const t_bvh	*bvh;
+	t_bvh_stack	stack;
+	int			node;
+	int			hit_found;
+
+	bvh = &scene->accel->bvh;
+	hit_found = 0;
+	stack.inv_dir = ray_inverse_direction(ray);
+	stack.size = 0;
+	if (bvh->num_prims > 0)
+		push_node(&stack, 0, aabb_entry(&bvh->nodes[0].box, &ray,
+				stack.inv_dir, hit_tmax(closest_hit, ray.tmax)));
+	while (stack.size > 0)
+	{
+		node = stack.node[--stack.size];
+		stack.tmax = hit_tmax(closest_hit, ray.tmax);
+		if (stack.entry[stack.size] > stack.tmax)
+			continue ;
+		if (!bvh_visit(scene->accel, node))
+			push_children(bvh, node, ray, &stack);
+		else if (bvh_trace_leaf(scene, &bvh->nodes[node], ray, closest_hit))
+			hit_found = 1;
+	}
+	return (hit_found);
+}
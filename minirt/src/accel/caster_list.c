@@ -0,0 +1,108 @@
+#include "../../includes/minirt_app.h"
+#include "../../includes/accel.h"
+
+/*
+** Append an item at position count, doubling the item array when full
+*/
+static void	casters_push(t_caster_lists *casters, int count, int item)
+{
+	int	*items;
+
+	if (count == casters->capacity)
+	{
+		casters->capacity = casters->capacity * 2 + 64;
+		items = malloc(sizeof(int) * casters->capacity);
+		if (!items)
+			error_exit(ERR_MEMORY);
+		if (count > 0)
+			ft_memcpy(items, casters->items, sizeof(int) * count);
+		free(casters->items);
+		casters->items = items;
+	}
+	casters->items[count] = item;
+}
+
+/*
+** Count the planes that may shadow the receiver
+*/
+static int	count_plane_casters(const t_accel *accel, const t_scene *scene,
+		int receiver)
+{
+	int	count;
+	int	i;
+
+	count = 0;
+	i = -1;
+	while (++i < accel->planes.count)
+		count += caster_may_shadow(scene, accel, accel->planes.index[i],
+				receiver);
+	return (count);
+}
+
+/*
+** Test every object against every receiver; each receiver's bounded
+** casters are contiguous, in object order
+*/
+static void	caster_lists_build(t_caster_lists *casters, const t_accel *accel,
+		const t_scene *scene)
+{
+	int	count;
+	int	receiver;
+	int	obj;
+	int	i;
+
+	count = 0;
+	receiver = -1;
+	while (++receiver < scene->num_objects)
+	{
+		casters->start[receiver] = count;
+		casters->num_planes[receiver] = count_plane_casters(accel, scene,
+				receiver);
+		i = -1;
+		while (++i < accel->num_bounded)
+		{
+			obj = accel->bounded[i];
+			if (caster_may_shadow(scene, accel, obj, receiver))
+				casters_push(casters, count++, obj);
+		}
+	}
+	casters->start[scene->num_objects] = count;
+}
+
+/*
+** Rebuild the caster lists after edits or when the light has moved, once
+** the light cones are up to date; larger scenes keep none, and their
+** shadow rays fall back to the light cones or the selected structure
+*/
+void	caster_lists_update(t_accel *accel, const t_scene *scene)
+{
+	t_caster_lists	*casters;
+
+	casters = &accel->casters;
+	if (casters->valid && casters->light.x == scene->light.position.x
+		&& casters->light.y == scene->light.position.y
+		&& casters->light.z == scene->light.position.z)
+		return ;
+	casters->valid = 0;
+	if (scene->num_objects > CASTER_MAX_OBJECTS)
+		return ;
+	if (!casters->start)
+		casters->start = malloc(sizeof(int) * (scene->num_objects + 1));
+	if (!casters->num_planes)
+		casters->num_planes = malloc(sizeof(int) * (scene->num_objects + 1));
+	if (!casters->start || !casters->num_planes)
+		error_exit(ERR_MEMORY);
+	caster_lists_build(casters, accel, scene);
+	casters->light = scene->light.position;
+	casters->valid = 1;
+}
+
+/*
+** Release the caster lists
+*/
+void	caster_lists_free(t_caster_lists *casters)
+{
+	free(casters->start);
+	free(casters->num_planes);
+	free(casters->items);
+}
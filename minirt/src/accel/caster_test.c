@@ -0,0 +1,94 @@
+#include "../../includes/minirt_app.h"
+#include "../../includes/accel.h"
+
+/*
+** Signed distance from a plane to p, positive on the light's side; 0 when
+** the light lies on the plane, which keeps every test conservative
+*/
+double	plane_light_side(const t_plane *plane, t_point3 light, t_point3 p)
+{
+	double	side_light;
+	double	side;
+
+	side_light = vec3_dot(vec3_sub(light, plane->point), plane->normal);
+	if (side_light == 0.0)
+		return (0.0);
+	side = vec3_dot(vec3_sub(p, plane->point), plane->normal)
+		/ vec3_length(plane->normal);
+	if (side_light < 0.0)
+		return (-side);
+	return (side);
+}
+
+/*
+** Occluders of a plane receiver: another plane, unless parallel with the
+** receiver strictly on its light side; a bounded object, unless its
+** bounding sphere lies wholly behind the receiver as seen from the light
+*/
+static int	may_shadow_plane(const t_scene *scene, const t_plane *receiver,
+		int occluder)
+{
+	const t_object	*obj;
+	const t_plane	*plane;
+	t_point3		center;
+	double			radius;
+	t_vec3			cross;
+
+	obj = &scene->objects[occluder];
+	if (obj->type != PLANE)
+	{
+		radius = sqrt(object_bound_sphere(obj, &center));
+		return (plane_light_side(receiver, scene->light.position, center)
+			>= -radius);
+	}
+	plane = &obj->data.plane;
+	cross = vec3_cross(receiver->normal, plane->normal);
+	if (vec3_dot(cross, cross) > 1e-12 * vec3_dot(receiver->normal,
+			receiver->normal) * vec3_dot(plane->normal, plane->normal))
+		return (1);
+	return (plane_light_side(plane, scene->light.position, receiver->point)
+		<= 0.0);
+}
+
+/*
+** Whether an occluder's light cone can hide part of a receiver's: the
+** occluder starts nearer the light than the receiver ends, and the cones
+** overlap, their axes being at most the sum of the half angles apart
+*/
+int	bound_cones_overlap(const t_bound_cone *occluder,
+		const t_bound_cone *receiver)
+{
+	if (occluder->near >= receiver->far)
+		return (0);
+	if (occluder->cos_sq < 0.0 || receiver->cos_sq < 0.0)
+		return (1);
+	return (vec3_dot(occluder->axis, receiver->axis)
+		>= occluder->cos * receiver->cos - occluder->sin * receiver->sin
+		- EPSILON);
+}
+
+/*
+** Conservative test of whether the occluder can block any shadow ray
+** from the light to the receiver, using bounding spheres; planes never
+** shadow themselves, other objects are always kept for their own shadows
+** Returns 1 if the occluder belongs in the receiver's caster list
+*/
+int	caster_may_shadow(const t_scene *scene, const t_accel *accel,
+		int occluder, int receiver)
+{
+	const t_object	*obj;
+	t_point3		center;
+	double			radius;
+
+	obj = &scene->objects[receiver];
+	if (occluder == receiver)
+		return (obj->type != PLANE);
+	if (obj->type == PLANE)
+		return (may_shadow_plane(scene, &obj->data.plane, occluder));
+	if (scene->objects[occluder].type != PLANE)
+		return (bound_cones_overlap(&accel->light_cones[occluder],
+				&accel->light_cones[receiver]));
+	radius = sqrt(object_bound_sphere(obj, &center));
+	return (plane_light_side(&scene->objects[occluder].data.plane,
+			scene->light.position, center) <= radius);
+}
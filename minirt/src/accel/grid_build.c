@@ -0,0 +1,140 @@
+#include "../../includes/minirt_app.h"
+#include "../../includes/accel.h"
+
+/*
+** Pick about GRID_DENSITY objects per cell: k cells per unit length,
+** with the box padded so flat scenes still have a volume
+*/
+static void	grid_resolution(t_grid *grid, int count)
+{
+	t_vec3	extent;
+	double	k;
+	int		axis;
+
+	grid->box.min = vec3_sub(grid->box.min, vec3_create(EPSILON, EPSILON,
+				EPSILON));
+	grid->box.max = vec3_add(grid->box.max, vec3_create(EPSILON, EPSILON,
+				EPSILON));
+	extent = vec3_sub(grid->box.max, grid->box.min);
+	k = cbrt(GRID_DENSITY * count / (extent.x * extent.y * extent.z));
+	axis = -1;
+	while (++axis < 3)
+	{
+		grid->res[axis] = (int)(vec3_component(extent, axis) * k);
+		if (grid->res[axis] < 1)
+			grid->res[axis] = 1;
+		if (grid->res[axis] > GRID_MAX_RES)
+			grid->res[axis] = GRID_MAX_RES;
+	}
+	grid->cell_size = vec3_create(extent.x / grid->res[0],
+			extent.y / grid->res[1], extent.z / grid->res[2]);
+	grid->inv_cell_size = vec3_create(1.0 / grid->cell_size.x,
+			1.0 / grid->cell_size.y, 1.0 / grid->cell_size.z);
+	grid->num_cells = grid->res[0] * grid->res[1] * grid->res[2];
+}
+
+/*
+** Cell coordinate of a world position along one axis, clamped to the grid
+*/
+int	grid_cell_coord(const t_grid *grid, t_vec3 p, int axis)
+{
+	int	cell;
+
+	cell = (int)((vec3_component(p, axis)
+				- vec3_component(grid->box.min, axis))
+			* vec3_component(grid->inv_cell_size, axis));
+	if (cell < 0)
+		return (0);
+	if (cell >= grid->res[axis])
+		return (grid->res[axis] - 1);
+	return (cell);
+}
+
+/*
+** Visit every cell the box of object obj overlaps: count it into
+** cell_start[c + 1], or, with fill set, append obj at the cell cursor
+*/
+static void	insert_object(t_grid *grid, const t_aabb *box, int obj,
+		int fill)
+{
+	int	lo[3];
+	int	c[3];
+	int	cell;
+
+	lo[0] = grid_cell_coord(grid, box->min, 0);
+	lo[1] = grid_cell_coord(grid, box->min, 1);
+	lo[2] = grid_cell_coord(grid, box->min, 2);
+	c[2] = lo[2] - 1;
+	while (++c[2] <= grid_cell_coord(grid, box->max, 2))
+	{
+		c[1] = lo[1] - 1;
+		while (++c[1] <= grid_cell_coord(grid, box->max, 1))
+		{
+			c[0] = lo[0] - 1;
+			while (++c[0] <= grid_cell_coord(grid, box->max, 0))
+			{
+				cell = (c[2] * grid->res[1] + c[1]) * grid->res[0] + c[0];
+				if (fill)
+					grid->cell_items[grid->cell_start[cell]++] = obj;
+				else
+					grid->cell_start[cell + 1]++;
+			}
+		}
+	}
+}
+
+/*
+** Bucket the bounded objects in three passes: count objects per cell,
+** prefix-sum the counts, then fill the cells
+** The fill pass advances each cell_start to the next cell's start,
+** so the offsets are shifted back by one cell afterwards
+*/
+static void	fill_cells(t_grid *grid, const t_accel *accel)
+{
+	int	i;
+
+	i = -1;
+	while (++i < accel->num_bounded)
+		insert_object(grid, &accel->bounds[accel->bounded[i]],
+			accel->bounded[i], FALSE);
+	i = -1;
+	while (++i < grid->num_cells)
+		grid->cell_start[i + 1] += grid->cell_start[i];
+	grid->cell_items = malloc(sizeof(int) * (grid->cell_start[i] + 1));
+	if (!grid->cell_items)
+		error_exit(ERR_MEMORY);
+	i = -1;
+	while (++i < accel->num_bounded)
+		insert_object(grid, &accel->bounds[accel->bounded[i]],
+			accel->bounded[i], TRUE);
+	i = grid->num_cells;
+	while (--i > 0)
+		grid->cell_start[i] = grid->cell_start[i - 1];
+	grid->cell_start[0] = 0;
+}
+
+/*
+** Build the uniform grid over the bounded objects
+*/
+void	grid_build(t_accel *accel)
+{
+	t_grid	*grid;
+	int		i;
+
+	grid = &accel->grid;
+	grid_free(grid);
+	grid->box = aabb_empty();
+	i = -1;
+	while (++i < accel->num_bounded)
+		grid->box = aabb_union(grid->box, accel->bounds[accel->bounded[i]]);
+	if (accel->num_bounded == 0)
+	{
+		grid->box.min = vec3_create(0.0, 0.0, 0.0);
+		grid->box.max = grid->box.min;
+	}
+	grid_resolution(grid, accel->num_bounded + 1);
+	grid->cell_start = ft_calloc(grid->num_cells + 1, sizeof(int));
+	if (!grid->cell_start)
+		error_exit(ERR_MEMORY);
+	fill_cells(grid, accel);
+}
@@ -0,0 +1,113 @@
+#include "../../includes/minirt_app.h"
+#include "../../includes/accel.h"
+
+/*
+** Start the walk in the cell holding the entry point p: per axis, the
+** step direction, the distance to the first boundary and between two
+*/
+static void	dda_setup(t_dda *dda, const t_grid *grid, t_ray ray, t_vec3 p)
+{
+	t_vec3	inv_dir;
+	double	inv;
+	double	size;
+	int		a;
+
+	inv_dir = ray_inverse_direction(ray);
+	a = -1;
+	while (++a < 3)
+	{
+		dda->cell[a] = grid_cell_coord(grid, p, a);
+		inv = vec3_component(inv_dir, a);
+		size = vec3_component(grid->cell_size, a);
+		dda->step[a] = 1;
+		if (inv < 0.0)
+			dda->step[a] = -1;
+		dda->next[a] = (vec3_component(grid->box.min, a)
+				+ (dda->cell[a] + (dda->step[a] > 0)) * size
+				- vec3_component(ray.origin, a)) * inv;
+		dda->delta[a] = size * inv * dda->step[a];
+	}
+}
+
+/*
+** Step into the next cell along the ray
+** Returns 0 once the walk has left the grid or passed tmax
+*/
+static int	dda_advance(t_dda *dda, const t_grid *grid, double tmax)
+{
+	int	axis;
+
+	axis = 2;
+	if (dda->next[0] < dda->next[1] && dda->next[0] < dda->next[2])
+		axis = 0;
+	else if (dda->next[1] < dda->next[2])
+		axis = 1;
+	if (dda->next[axis] > fmin(dda->exit, tmax))
+		return (0);
+	dda->cell[axis] += dda->step[axis];
+	if (dda->cell[axis] < 0 || dda->cell[axis] >= grid->res[axis])
+		return (0);
+	dda->next[axis] += dda->delta[axis];
+	return (1);
+}
+
+/*
+** Test the objects listed in the current cell
+** Objects spanning several cells are tested again in each of them; the
+** closest-hit comparison makes the repeats harmless
+** Returns 1 if any hit, 0 if no hit
+*/
+static int	trace_cell(const t_scene *scene, const t_dda *dda, t_ray ray,
+		t_hit *closest_hit)
+{
+	const t_grid	*grid;
+	int				cell;
+	int				hit_found;
+	int				i;
+
+	grid = &scene->accel->grid;
+	cell = (dda->cell[2] * grid->res[1] + dda->cell[1]) * grid->res[0]
+		+ dda->cell[0];
+	hit_found = 0;
+	i = grid->cell_start[cell];
+	while (i < grid->cell_start[cell + 1])
+	{
+		if (trace_object(scene, ray, closest_hit, grid->cell_items[i]))
+			hit_found = 1;
+		i++;
+	}
+	return (hit_found);
+}
+
+/*
+** Walk the cells along the ray with a 3D-DDA, front to back
+** The walk stops once the closest hit lies inside the current cell:
+** objects not met yet only overlap cells further along the ray
+** Returns 1 if any hit, 0 if no hit
+*/
+int	grid_trace(const t_scene *scene, t_ray ray, t_hit *closest_hit)
+{
+	const t_grid	*grid;
+	t_dda			dda;
+	double			range[2];
+	int				hit_found;
+
+	grid = &scene->accel->grid;
+	range[0] = 0.0;
+	range[1] = hit_tmax(closest_hit, ray.tmax);
+	if (grid->num_cells == 0 || !aabb_clip(&grid->box, &ray,
+			ray_inverse_direction(ray), range))
+		return (0);
+	dda_setup(&dda, grid, ray, vec3_add(ray.origin,
+			vec3_mult(ray.direction, range[0])));
+	dda.exit = range[1];
+	hit_found = 0;
+	while (1)
+	{
+		if (trace_cell(scene, &dda, ray, closest_hit))
+			hit_found = 1;
+		if (!dda_advance(&dda, grid, hit_tmax(closest_hit, ray.tmax)))
+			break ;
+	}
+	return (hit_found);
+}
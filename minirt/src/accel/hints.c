@@ -0,0 +1,85 @@
+#include "../../includes/minirt_app.h"
+#include "../../includes/accel.h"
+#include "../../includes/stats.h"
+
+/*
+** Clear the hints, for a caller starting to trace
+*/
+void	hints_init(t_hints *hints)
+{
+	hints->primary = -1;
+	hints->occluder = -1;
+}
+
+/*
+** Start a primary ray at the object the caller's previous one hit: its
+** hit, if any, seeds closest_hit and closes the ray's interval, so the
+** full traversal only looks for nearer objects
+** Returns 1 if the hinted object was hit
+*/
+int	primary_hint_seed(t_hints *hints, const t_scene *scene, t_ray *ray,
+		t_hit *closest_hit)
+{
+	int	hint;
+
+	closest_hit->t = -1.0;
+	if (!hints || hints->primary < 0)
+		return (0);
+	hint = hints->primary;
+	g_stats.primary_hints++;
+	if (!trace_object(scene, *ray, closest_hit, hint))
+		return (0);
+	ray->tmax = closest_hit->t;
+	return (1);
+}
+
+/*
+** Count a hint that held (the hinted object stayed the closest) and hint
+** the next primary ray with this one's object; planes are not hinted,
+** as they are tested first anyway, by their vectorised kernel
+*/
+void	primary_hint_update(t_hints *hints, const t_scene *scene,
+		const t_hit *hit, int hit_found)
+{
+	int	hint;
+
+	if (!hints)
+		return ;
+	hint = -1;
+	if (hit_found && scene->objects[hit->obj_index].type != PLANE)
+		hint = hit->obj_index;
+	if (hint >= 0 && hint == hints->primary)
+		g_stats.primary_hint_hits++;
+	hints->primary = hint;
+}
+
+/*
+** Test the caller's last shadow ray's occluder first; any hit will do
+** Returns 1 if it blocks this ray too
+*/
+int	occluder_hint_blocks(t_hints *hints, const t_scene *scene, t_ray ray,
+		t_hit *closest_hit)
+{
+	int	hint;
+
+	closest_hit->t = -1.0;
+	if (!hints || !scene->accel || hints->occluder < 0)
+		return (0);
+	hint = hints->occluder;
+	g_stats.occluder_hints++;
+	if (!trace_object(scene, ray, closest_hit, hint))
+		return (0);
+	g_stats.occluder_hint_hits++;
+	return (1);
+}
+
+/*
+** Remember the occluder a full search found; a lit point keeps the hint,
+** since its neighbours may still be shadowed by the same object
+*/
+void	occluder_hint_update(t_hints *hints, const t_scene *scene,
+		const t_hit *hit, int blocked)
+{
+	if (hints && scene->accel && blocked)
+		hints->occluder = hit->obj_index;
+}
@@ -0,0 +1,131 @@
+#include "../../includes/minirt_app.h"
+#include "../../includes/accel.h"
+#include "../../includes/stats.h"
+
+/*
+** Quantise a hit point to its world-space cell and hash the cell with
+** the hit's object
+** Returns the home slot of the cell, or -1 if the hit is too far out
+*/
+static int	cell_slot(const t_hit *hit, int *cell)
+{
+	double			p[3];
+	unsigned int	hash;
+	int				axis;
+
+	p[0] = hit->point.x;
+	p[1] = hit->point.y;
+	p[2] = hit->point.z;
+	hash = (unsigned int)hit->obj_index * 2654435761u;
+	axis = -1;
+	while (++axis < 3)
+	{
+		if (!(fabs(p[axis]) < LIGHT_CACHE_RANGE))
+			return (-1);
+		cell[axis] = (int)floor(p[axis] / LIGHT_CACHE_CELL);
+		hash = (hash ^ (unsigned int)cell[axis]) * 16777619u;
+	}
+	hash ^= hash >> 15;
+	return (hash & (LIGHT_CACHE_SIZE - 1));
+}
+
+/*
+** Whether a slot holds a current entry for this object and cell
+*/
+static int	entry_matches(const t_light_cache *cache, int slot, int object,
+		const int *cell)
+{
+	const t_light_entry	*entry;
+
+	entry = &cache->entries[slot & (LIGHT_CACHE_SIZE - 1)];
+	return (entry->stamp == cache->stamp && entry->object == object
+		&& entry->cell[0] == cell[0] && entry->cell[1] == cell[1]
+		&& entry->cell[2] == cell[2]);
+}
+
+/*
+** Shadow state cached for the cell of a hit facing the light
+** Returns 1 if lit, 0 if shadowed, -1 if unknown (or the cache is off)
+*/
+int	light_cache_lookup(const t_scene *scene, const t_hit *hit)
+{
+	const t_light_cache	*cache;
+	int					cell[3];
+	int					slot;
+	int					i;
+
+	if (!scene->accel || !scene->accel->light_cache.entries)
+		return (-1);
+	cache = &scene->accel->light_cache;
+	slot = cell_slot(hit, cell);
+	if (slot < 0)
+		return (-1);
+	g_stats.light_cache_lookups++;
+	i = -1;
+	while (++i < LIGHT_CACHE_PROBE)
+	{
+		if (entry_matches(cache, slot + i, hit->obj_index, cell))
+		{
+			g_stats.light_cache_hits++;
+			return (cache->entries[(slot + i)
+					& (LIGHT_CACHE_SIZE - 1)].lit);
+		}
+	}
+	return (-1);
+}
+
+/*
+** Record the shadow state traced for a hit in its cell's slot: the cell's
+** entry, else the first free or stale slot probed, else the last one,
+** evicting its entry
+*/
+void	light_cache_store(const t_scene *scene, const t_hit *hit, int lit)
+{
+	t_light_cache	*cache;
+	t_light_entry	*entry;
+	int				cell[3];
+	int				slot;
+	int				i;
+
+	if (!scene->accel || !scene->accel->light_cache.entries)
+		return ;
+	cache = &scene->accel->light_cache;
+	slot = cell_slot(hit, cell);
+	if (slot < 0)
+		return ;
+	i = 0;
+	while (i < LIGHT_CACHE_PROBE - 1
+		&& cache->entries[(slot + i) & (LIGHT_CACHE_SIZE - 1)].stamp
+		== cache->stamp
+		&& !entry_matches(cache, slot + i, hit->obj_index, cell))
+		i++;
+	entry = &cache->entries[(slot + i) & (LIGHT_CACHE_SIZE - 1)];
+	entry->object = hit->obj_index;
+	ft_memcpy(entry->cell, cell, sizeof(cell));
+	entry->stamp = cache->stamp;
+	entry->lit = lit;
+}
+
+/*
+** Empty the cache if the light has moved since it was filled, by moving
+** to a new stamp; called before each frame and relight
+*/
+void	light_cache_update(t_light_cache *cache, const t_scene *scene)
+{
+	t_point3	light;
+
+	if (!cache->entries)
+		return ;
+	light = scene->light.position;
+	if (cache->valid && light.x == cache->light.x
+		&& light.y == cache->light.y && light.z == cache->light.z)
+		return ;
+	cache->stamp++;
+	if (cache->stamp == 0)
+	{
+		ft_bzero(cache->entries, sizeof(t_light_entry) * LIGHT_CACHE_SIZE);
+		cache->stamp = 1;
+	}
+	cache->light = light;
+	cache->valid = 1;
+}
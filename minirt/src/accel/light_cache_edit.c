@@ -0,0 +1,83 @@
+#include "../../includes/minirt_app.h"
+#include "../../includes/accel.h"
+
+/*
+** Set up the light cache; its table is only allocated when enabled
+*/
+void	light_cache_init(t_light_cache *cache, int enabled)
+{
+	cache->entries = NULL;
+	cache->stamp = 1;
+	cache->valid = 0;
+	if (!enabled)
+		return ;
+	cache->entries = ft_calloc(LIGHT_CACHE_SIZE, sizeof(t_light_entry));
+	if (!cache->entries)
+		error_exit(ERR_MEMORY);
+}
+
+/*
+** Release the light cache's table
+*/
+void	light_cache_free(t_light_cache *cache)
+{
+	free(cache->entries);
+	cache->entries = NULL;
+	cache->valid = 0;
+}
+
+/*
+** Whether an object, within one of its light cones (before and after an
+** edit), can block a shadow ray from the light to any point of a cell:
+** the test of the caster lists, against the sphere around the cell
+*/
+static int	cell_may_change(const t_light_entry *entry,
+		const t_bound_cone *cones, t_point3 light)
+{
+	t_bound_cone	cell_cone;
+	t_point3		center;
+
+	center = vec3_create((entry->cell[0] + 0.5) * LIGHT_CACHE_CELL,
+			(entry->cell[1] + 0.5) * LIGHT_CACHE_CELL,
+			(entry->cell[2] + 0.5) * LIGHT_CACHE_CELL);
+	bound_cone_init(&cell_cone, center,
+		0.75 * LIGHT_CACHE_CELL * LIGHT_CACHE_CELL, light);
+	return (bound_cones_overlap(&cones[0], &cell_cone)
+		|| bound_cones_overlap(&cones[1], &cell_cone));
+}
+
+/*
+** Drop the entries an edited object may have changed: its own, and those
+** of the cells its light cone covered before the edit (still in
+** light_cones) or covers now, which then replaces it; a plane edit
+** empties the whole cache before the next frame
+** Called once the object's bounding sphere is up to date
+*/
+void	light_cache_invalidate(t_accel *accel, const t_scene *scene,
+		int obj_index)
+{
+	t_light_cache	*cache;
+	t_bound_cone	cones[2];
+	t_point3		center;
+	double			radius_sq;
+	int				i;
+
+	cache = &accel->light_cache;
+	if (!cache->entries || !cache->valid)
+		return ;
+	if (scene->objects[obj_index].type == PLANE)
+	{
+		cache->valid = 0;
+		return ;
+	}
+	cones[0] = accel->light_cones[obj_index];
+	radius_sq = object_bound_sphere(&scene->objects[obj_index], &center);
+	bound_cone_init(&cones[1], center, radius_sq, cache->light);
+	accel->light_cones[obj_index] = cones[1];
+	i = -1;
+	while (++i < LIGHT_CACHE_SIZE)
+		if (cache->entries[i].stamp == cache->stamp
+			&& (cache->entries[i].object == obj_index
+				|| cell_may_change(&cache->entries[i], cones, cache->light)))
+			cache->entries[i].stamp = 0;
+}
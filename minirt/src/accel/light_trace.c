@@ -0,0 +1,111 @@
+#include "../../includes/minirt_app.h"
+#include "../../includes/accel.h"
+
+/*
+** Whether a direction from the light falls outside an object's cone
+*/
+int	bound_cone_rejects(const t_bound_cone *cone, t_vec3 dir)
+{
+	double	d;
+
+	if (cone->cos_sq < 0.0)
+		return (0);
+	d = vec3_dot(cone->axis, dir);
+	return (d <= 0.0 || d * d < cone->cos_sq);
+}
+
+/*
+** Occlusion test over the flat list: the planes, then every bounded
+** object whose light cone holds the ray direction; any hit will do, so
+** the search stops at the first one
+** Returns 1 if anything blocks the ray, 0 otherwise
+*/
+static int	trace_light_list(const t_scene *scene, t_ray ray,
+		t_hit *closest_hit)
+{
+	const t_accel	*accel;
+	int				obj;
+	int				i;
+
+	accel = scene->accel;
+	if (trace_planes(scene, ray, closest_hit))
+		return (1);
+	i = -1;
+	while (++i < accel->num_bounded)
+	{
+		obj = accel->bounded[i];
+		if (!bound_cone_rejects(&accel->light_cones[obj], ray.direction)
+			&& trace_object(scene, ray, closest_hit, obj))
+			return (1);
+	}
+	return (0);
+}
+
+/*
+** Occlusion test over the receiver's casters: the plane list if any plane
+** may shadow it, then its bounded casters whose light cones hold the ray
+** Returns 1 if anything blocks the ray, 0 otherwise
+*/
+static int	trace_caster_list(const t_scene *scene, t_ray ray, int receiver,
+		t_hit *closest_hit)
+{
+	const t_caster_lists	*casters;
+	int						obj;
+	int						i;
+
+	casters = &scene->accel->casters;
+	if (casters->num_planes[receiver] > 0
+		&& trace_planes(scene, ray, closest_hit))
+		return (1);
+	i = casters->start[receiver] - 1;
+	while (++i < casters->start[receiver + 1])
+	{
+		obj = casters->items[i];
+		if (!bound_cone_rejects(&scene->accel->light_cones[obj], ray.direction)
+			&& trace_object(scene, ray, closest_hit, obj))
+			return (1);
+	}
+	return (0);
+}
+
+/*
+** Search the occluders of a shadow ray cast from the light towards a
+** point of the receiver object; their origin terms come from the light's
+** cache. Only the receiver's caster list is tested when the lists are
+** built; otherwise the flat list tests the light cones and the other
+** modes their own structure
+** Returns 1 if anything blocks the ray within its interval, 0 otherwise
+*/
+static int	trace_occluders(const t_scene *scene, t_ray ray, int receiver,
+		t_hit *closest_hit)
+{
+	const t_accel	*accel;
+
+	accel = scene->accel;
+	if (!accel || !origin_cache_matches(&accel->light, ray.origin))
+		return (trace_objects(scene, ray, closest_hit));
+	closest_hit->t = -1.0;
+	if (accel->casters.valid && receiver >= 0)
+		return (trace_caster_list(scene, ray, receiver, closest_hit));
+	if (accel->mode != ACCEL_NONE)
+		return (trace_objects(scene, ray, closest_hit));
+	return (trace_light_list(scene, ray, closest_hit));
+}
+
+/*
+** Trace a shadow ray, testing the caller's last shadow ray's occluder
+** before the full search (hints may be NULL)
+** Returns 1 if anything blocks the ray within its interval, 0 otherwise
+*/
+int	trace_shadow(const t_scene *scene, t_ray ray, int receiver,
+		t_hints *hints)
+{
+	t_hit	closest_hit;
+	int		blocked;
+
+	if (occluder_hint_blocks(hints, scene, ray, &closest_hit))
+		return (1);
+	blocked = trace_occluders(scene, ray, receiver, &closest_hit);
+	occluder_hint_update(hints, scene, &closest_hit, blocked);
+	return (blocked);
+}
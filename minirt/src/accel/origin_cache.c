@@ -0,0 +1,99 @@
+#include "../../includes/minirt_app.h"
+#include "../../includes/accel.h"
+
+/*
+** Fill the cache with the origin terms of every object for rays starting
+** at origin; linear in the number of objects, so it is simply redone
+** before each frame, which also picks up edited objects
+*/
+void	origin_cache_update(t_origin_cache *cache, const t_scene *scene,
+		t_point3 origin)
+{
+	int	i;
+
+	i = -1;
+	while (++i < scene->num_objects)
+	{
+		if (scene->objects[i].type == PLANE)
+			continue ;
+		object_bound_terms(&scene->objects[i], origin, &cache->terms[i]);
+		object_origin_terms(&scene->objects[i], origin, &cache->terms[i]);
+	}
+	cache->origin = origin;
+	cache->valid = 1;
+}
+
+/*
+** Whether rays from origin can use the cache; exact comparison, since
+** cached rays copy their origin from the camera or light position
+*/
+int	origin_cache_matches(const t_origin_cache *cache, t_point3 origin)
+{
+	return (cache->valid && origin.x == cache->origin.x
+		&& origin.y == cache->origin.y && origin.z == cache->origin.z);
+}
+
+/*
+** Bounding sphere of a sphere, cylinder or cone, padded like the boxes
+** Returns its squared radius
+*/
+double	object_bound_sphere(const t_object *obj, t_point3 *center)
+{
+	double	radius;
+
+	if (obj->type == SPHERE)
+	{
+		*center = obj->data.sphere.center;
+		radius = obj->data.sphere.diameter / 2.0 + EPSILON;
+		return (radius * radius);
+	}
+	if (obj->type == CYLINDER)
+	{
+		*center = obj->data.cylinder.bound.center;
+		return (obj->data.cylinder.bound.radius_sq);
+	}
+	*center = obj->data.cone.bound.center;
+	return (obj->data.cone.bound.radius_sq);
+}
+
+/*
+** Set up the cone from the light around a sphere
+*/
+void	bound_cone_init(t_bound_cone *cone, t_point3 center, double radius_sq,
+		t_point3 light)
+{
+	double	dist;
+
+	cone->axis = vec3_sub(center, light);
+	dist = vec3_length(cone->axis);
+	cone->near = dist - sqrt(radius_sq);
+	cone->far = dist + sqrt(radius_sq);
+	cone->cos_sq = -1.0;
+	if (dist * dist <= radius_sq)
+		return ;
+	cone->axis = vec3_div(cone->axis, dist);
+	cone->cos_sq = 1.0 - radius_sq / (dist * dist);
+	cone->cos = sqrt(cone->cos_sq);
+	cone->sin = sqrt(radius_sq) / dist;
+}
+
+/*
+** Build the light-centred bounding cone of every bounded object; a shadow
+** ray cast from the light can only hit objects whose cone holds its
+** direction
+*/
+void	light_cones_update(t_accel *accel, const t_scene *scene)
+{
+	t_point3	center;
+	double		radius_sq;
+	int			i;
+
+	i = -1;
+	while (++i < accel->num_bounded)
+	{
+		radius_sq = object_bound_sphere(&scene->objects[accel->bounded[i]],
+				&center);
+		bound_cone_init(&accel->light_cones[accel->bounded[i]], center,
+			radius_sq, scene->light.position);
+	}
+}
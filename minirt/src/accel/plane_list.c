@@ -0,0 +1,103 @@
+#include "../../includes/minirt_app.h"
+#include "../../includes/accel.h"
+
+/*
+** Gather the scene's planes into the structure-of-arrays plane list
+** The arrays are sized for the whole object array, so rebuilding after
+** an edit never reallocates
+*/
+void	plane_list_build(t_plane_list *list, const t_scene *scene)
+{
+	const t_plane	*plane;
+	int				i;
+
+	list->count = 0;
+	i = 0;
+	while (i < scene->num_objects)
+	{
+		if (scene->objects[i].type == PLANE)
+		{
+			plane = &scene->objects[i].data.plane;
+			list->nx[list->count] = plane->normal.x;
+			list->ny[list->count] = plane->normal.y;
+			list->nz[list->count] = plane->normal.z;
+			list->d[list->count] = vec3_dot(plane->normal, plane->point);
+			list->index[list->count] = i;
+			list->count++;
+		}
+		i++;
+	}
+}
+
+/*
+** Branch-free plane kernel over one chunk: distances of all planes in
+** [first, first + n), with misses and distances outside the ray's
+** interval set to DBL_MAX. The loop has no dependencies between
+** iterations, so the compiler vectorises it.
+*/
+static void	plane_chunk_distances(const t_plane_list *list, t_ray ray,
+		int first, double *t)
+{
+	double	denom;
+	int		k;
+
+	k = 0;
+	while (k < PLANE_CHUNK && first + k < list->count)
+	{
+		denom = list->nx[first + k] * ray.direction.x
+			+ list->ny[first + k] * ray.direction.y
+			+ list->nz[first + k] * ray.direction.z;
+		t[k] = (list->d[first + k] - (list->nx[first + k] * ray.origin.x
+					+ list->ny[first + k] * ray.origin.y
+					+ list->nz[first + k] * ray.origin.z)) / denom;
+		if (fabs(denom) < 0.0001 || t[k] <= ray.tmin || t[k] >= ray.tmax)
+			t[k] = DBL_MAX;
+		k++;
+	}
+}
+
+/*
+** Find the nearest plane with the vectorised kernel, then fill the hit
+** record through intersect_plane for that plane only
+** Returns 1 if a plane was hit
+*/
+int	trace_planes(const t_scene *scene, t_ray ray, t_hit *closest_hit)
+{
+	const t_plane_list	*list;
+	double				t[PLANE_CHUNK];
+	double				best_t;
+	int					best;
+	int					k;
+
+	list = &scene->accel->planes;
+	best = -1;
+	best_t = DBL_MAX;
+	k = -1;
+	while (++k < list->count)
+	{
+		if (k % PLANE_CHUNK == 0)
+			plane_chunk_distances(list, ray, k, t);
+		if (t[k % PLANE_CHUNK] < best_t)
+		{
+			best_t = t[k % PLANE_CHUNK];
+			best = list->index[k];
+		}
+	}
+	if (best < 0 || !intersect_plane(&scene->objects[best].data.plane, ray,
+			closest_hit))
+		return (0);
+	closest_hit->obj_index = best;
+	return (1);
+}
+
+/*
+** Release the plane list
+*/
+void	plane_list_free(t_plane_list *list)
+{
+	free(list->nx);
+	free(list->ny);
+	free(list->nz);
+	free(list->d);
+	free(list->index);
+}
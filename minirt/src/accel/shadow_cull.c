@@ -0,0 +1,82 @@
+#include "../../includes/minirt_app.h"
+#include "../../includes/accel.h"
+#include "../../includes/stats.h"
+
+/*
+** Sphere around the box of the tile's hit points, and its cone from the
+** light: every shadow ray of the tile runs inside that cone
+*/
+static void	tile_cone(const t_scene *scene, const t_hit *hits,
+		t_shadow_tile *tile)
+{
+	t_aabb		box;
+	t_point3	p;
+	int			i;
+
+	box.min = hits[tile->pixels[0]].point;
+	box.max = box.min;
+	i = 0;
+	while (++i < tile->count)
+	{
+		p = hits[tile->pixels[i]].point;
+		box.min = vec3_create(fmin(box.min.x, p.x), fmin(box.min.y, p.y),
+				fmin(box.min.z, p.z));
+		box.max = vec3_create(fmax(box.max.x, p.x), fmax(box.max.y, p.y),
+				fmax(box.max.z, p.z));
+	}
+	tile->center = vec3_mult(vec3_add(box.min, box.max), 0.5);
+	tile->radius = vec3_length(vec3_sub(box.max, box.min)) / 2.0 + EPSILON;
+	bound_cone_init(&tile->cone, tile->center, tile->radius * tile->radius,
+		scene->light.position);
+}
+
+/*
+** Whether any plane may lie between the light and a hit of the tile
+*/
+static int	tile_planes(const t_scene *scene, const t_shadow_tile *tile)
+{
+	const t_plane_list	*planes;
+	int					i;
+
+	planes = &scene->accel->planes;
+	i = -1;
+	while (++i < planes->count)
+	{
+		if (plane_light_side(&scene->objects[planes->index[i]].data.plane,
+				scene->light.position, tile->center) <= tile->radius)
+			return (1);
+	}
+	return (0);
+}
+
+/*
+** Cull the scene once for all shadow rays of a tile: keep the planes
+** between the light and its hits, and the bounded objects whose light
+** cones overlap the tile's; linear in the number of objects
+*/
+void	shadow_tile_cull(const t_scene *scene, const t_hit *hits,
+		t_shadow_tile *tile)
+{
+	const t_accel	*accel;
+	int				obj;
+	int				i;
+
+	accel = scene->accel;
+	tile_cone(scene, hits, tile);
+	tile->planes = tile_planes(scene, tile);
+	tile->num_spheres = 0;
+	tile->num_others = 0;
+	i = -1;
+	while (++i < accel->num_bounded)
+	{
+		obj = accel->bounded[i];
+		if (!bound_cones_overlap(&accel->light_cones[obj], &tile->cone))
+			continue ;
+		if (scene->objects[obj].type == SPHERE)
+			tile->casters[tile->num_spheres++] = obj;
+		else
+			tile->casters[accel->num_objects - ++tile->num_others] = obj;
+	}
+	g_stats.shadow_tiles++;
+	g_stats.tile_casters += tile->num_spheres + tile->num_others;
+}
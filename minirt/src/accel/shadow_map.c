@@ -0,0 +1,55 @@
+#include "../../includes/minirt_app.h"
+#include "../../includes/accel.h"
+
+/*
+** Set up the shadow map; its arrays are only allocated with --shadows map
+*/
+void	shadow_map_init(t_shadow_map *map, const t_options *opts)
+{
+	long	texels;
+
+	map->depth = NULL;
+	map->block_valid = NULL;
+	map->res = opts->shadow_res;
+	map->blocks = (map->res + SHADOW_MAP_BLOCK - 1) / SHADOW_MAP_BLOCK;
+	map->bias = opts->shadow_bias;
+	map->valid = 0;
+	if (opts->shadows != SHADOWS_MAP)
+		return ;
+	texels = 6L * map->res * map->res;
+	map->depth = malloc(sizeof(float) * texels);
+	map->block_valid = malloc(6L * map->blocks * map->blocks);
+	if (!map->depth || !map->block_valid)
+		error_exit(ERR_MEMORY);
+}
+
+/*
+** Drop every traced block if the light has moved or an object was
+** edited since they were traced; called before each frame and relight
+*/
+void	shadow_map_update(t_shadow_map *map, const t_scene *scene)
+{
+	t_point3	light;
+
+	if (!map->depth)
+		return ;
+	light = scene->light.position;
+	if (map->valid && light.x == map->light.x && light.y == map->light.y
+		&& light.z == map->light.z)
+		return ;
+	ft_bzero(map->block_valid, 6L * map->blocks * map->blocks);
+	map->light = light;
+	map->valid = 1;
+}
+
+/*
+** Release the shadow map's arrays
+*/
+void	shadow_map_free(t_shadow_map *map)
+{
+	free(map->depth);
+	free(map->block_valid);
+	map->depth = NULL;
+	map->block_valid = NULL;
+	map->valid = 0;
+}
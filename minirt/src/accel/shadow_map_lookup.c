@@ -0,0 +1,126 @@
+#include "../../includes/minirt_app.h"
+#include "../../includes/accel.h"
+#include "../../includes/stats.h"
+
+/*
+** Unit direction from the light through the centre of texel (x, y) of a
+** cube face
+*/
+static t_vec3	texel_direction(const t_shadow_map *map, int face, int x,
+		int y)
+{
+	double	c[3];
+	int		axis;
+
+	axis = face / 2;
+	c[axis] = 1.0 - 2.0 * (face % 2);
+	c[(axis + 1) % 3] = (x + 0.5) * 2.0 / map->res - 1.0;
+	c[(axis + 2) % 3] = (y + 0.5) * 2.0 / map->res - 1.0;
+	return (vec3_normalize(vec3_create(c[0], c[1], c[2])));
+}
+
+/*
+** Trace texel (x, y) of a cube face from the light with the selected
+** structure, storing the distance to the nearest surface (FLT_MAX for
+** none)
+*/
+static void	texel_trace(const t_scene *scene, t_shadow_map *map, int face,
+		const int *xy)
+{
+	t_ray	ray;
+	t_hit	hit;
+	float	*depth;
+
+	depth = &map->depth[(face * map->res + xy[1]) * map->res + xy[0]];
+	ray.origin = map->light;
+	ray.direction = texel_direction(map, face, xy[0], xy[1]);
+	ray.tmin = MIN_T;
+	ray.tmax = DBL_MAX;
+	*depth = FLT_MAX;
+	if (trace_objects(scene, ray, &hit))
+		*depth = hit.t;
+	g_stats.shadow_map_texels++;
+}
+
+/*
+** Trace the texels of one block of the map
+*/
+static void	block_trace(const t_scene *scene, t_shadow_map *map, int block)
+{
+	int	face;
+	int	corner[2];
+	int	xy[2];
+	int	i;
+
+	face = block / (map->blocks * map->blocks);
+	corner[0] = block % map->blocks * SHADOW_MAP_BLOCK;
+	corner[1] = block / map->blocks % map->blocks * SHADOW_MAP_BLOCK;
+	i = -1;
+	while (++i < SHADOW_MAP_BLOCK * SHADOW_MAP_BLOCK)
+	{
+		xy[0] = corner[0] + i % SHADOW_MAP_BLOCK;
+		xy[1] = corner[1] + i / SHADOW_MAP_BLOCK;
+		if (xy[0] < map->res && xy[1] < map->res)
+			texel_trace(scene, map, face, xy);
+	}
+	map->block_valid[block] = 1;
+}
+
+/*
+** Texel of the cube face a direction from the light goes through, and
+** the block holding it
+** Returns the texel's index in depth
+*/
+static int	texel_index(const t_shadow_map *map, t_vec3 dir, int *block)
+{
+	double	c[3];
+	int		axis;
+	int		face;
+	int		u;
+	int		v;
+
+	c[0] = dir.x;
+	c[1] = dir.y;
+	c[2] = dir.z;
+	axis = 0;
+	if (fabs(c[1]) > fabs(c[axis]))
+		axis = 1;
+	if (fabs(c[2]) > fabs(c[axis]))
+		axis = 2;
+	face = axis * 2 + (c[axis] < 0.0);
+	u = (int)((c[(axis + 1) % 3] / fabs(c[axis]) + 1.0) * 0.5 * map->res);
+	v = (int)((c[(axis + 2) % 3] / fabs(c[axis]) + 1.0) * 0.5 * map->res);
+	u = fmax(0, fmin(u, map->res - 1));
+	v = fmax(0, fmin(v, map->res - 1));
+	*block = (face * map->blocks + v / SHADOW_MAP_BLOCK) * map->blocks
+		+ u / SHADOW_MAP_BLOCK;
+	return ((face * map->res + v) * map->res + u);
+}
+
+/*
+** Shadow test of a hit facing the light against the shadow map, tracing
+** the texel's block first if needed; the bias grows with the texel's
+** footprint at the hit's distance and with the slope of the surface
+** Returns 1 if lit, 0 if something nearer the light covers the texel
+*/
+int	shadow_map_lit(const t_scene *scene, const t_hit *hit)
+{
+	t_shadow_map	*map;
+	t_vec3			dir;
+	double			dist;
+	double			bias;
+	int				block;
+	int				texel;
+
+	map = &scene->accel->shadow_map;
+	dir = vec3_sub(hit->point, map->light);
+	dist = vec3_length(dir);
+	if (dist <= EPSILON)
+		return (1);
+	texel = texel_index(map, dir, &block);
+	if (!map->block_valid[block])
+		block_trace(scene, map, block);
+	bias = map->bias * 2.0 * dist / map->res
+		/ fmax(-vec3_dot(hit->normal, dir) / dist, SHADOW_MAP_MIN_COS);
+	return (dist <= map->depth[texel] + bias);
+}
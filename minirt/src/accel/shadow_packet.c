@@ -0,0 +1,142 @@
+#include "../../includes/minirt_app.h"
+#include "../../includes/accel.h"
+#include "../../includes/stats.h"
+
+/*
+** Load the tile's shadow rays from packet->first on into the lanes;
+** lanes past the tile's end repeat the first ray and start closed
+*/
+static void	packet_load(const t_scene *scene, const t_hit *hits,
+		const t_shadow_tile *tile, t_shadow_packet *packet)
+{
+	int	l;
+
+	packet->count = tile->count - packet->first;
+	if (packet->count > SHADOW_PACKET)
+		packet->count = SHADOW_PACKET;
+	l = -1;
+	while (++l < SHADOW_PACKET)
+	{
+		if (l < packet->count)
+			packet->rays[l] = shadow_ray(hits[tile->pixels[packet->first
+					+ l]].point, scene->light.position);
+		else
+			packet->rays[l] = packet->rays[0];
+		packet->dir[0][l] = packet->rays[l].direction.x;
+		packet->dir[1][l] = packet->rays[l].direction.y;
+		packet->dir[2][l] = packet->rays[l].direction.z;
+		packet->open[l] = -(l < packet->count);
+	}
+	packet->a = packet->dir[0] * packet->dir[0]
+		+ packet->dir[1] * packet->dir[1] + packet->dir[2] * packet->dir[2];
+	packet->num_open = packet->count;
+	g_stats.shadow_rays += packet->count;
+	g_stats.shadow_packets++;
+}
+
+/*
+** Solve the lanes a sphere's discriminant test let through, exactly as
+** the scalar sphere kernel does, and close those it occludes
+*/
+static void	packet_solve(t_shadow_packet *packet, double c)
+{
+	t_quadratic	q;
+	int			l;
+
+	l = -1;
+	while (++l < packet->count)
+	{
+		if (!packet->maybe[l])
+			continue ;
+		g_stats.packet_lanes++;
+		q.a = packet->a[l];
+		q.b = packet->b[l];
+		q.c = c;
+		if (solve_quadratic(q, packet->rays[l].tmin, packet->rays[l].tmax)
+			>= 0.0)
+		{
+			packet->open[l] = 0;
+			packet->num_open--;
+		}
+	}
+}
+
+/*
+** Test the open lanes against the tile's spheres, four discriminants at
+** once from the light's cached origin terms; most spheres miss every
+** lane here and never reach the square root
+*/
+static void	packet_spheres(const t_scene *scene, const t_shadow_tile *tile,
+		t_shadow_packet *packet)
+{
+	const t_origin_terms	*terms;
+	int						i;
+
+	i = -1;
+	while (++i < tile->num_spheres && packet->num_open > 0)
+	{
+		terms = &scene->accel->light.terms[tile->casters[i]];
+		packet->b = 2.0 * (terms->oc.x * packet->dir[0]
+				+ terms->oc.y * packet->dir[1] + terms->oc.z * packet->dir[2]);
+		packet->maybe = packet->open
+			& ~(packet->b * packet->b < 4.0 * packet->a * terms->c);
+		g_stats.packet_tests++;
+		if (packet->maybe[0] | packet->maybe[1] | packet->maybe[2]
+			| packet->maybe[3])
+		{
+			g_stats.packet_solves++;
+			packet_solve(packet, terms->c);
+		}
+	}
+}
+
+/*
+** Scalar part of a lane's occlusion test: the plane list if a plane may
+** block the tile, then its cylinders and cones
+** Returns 1 if anything blocks the ray, 0 otherwise
+*/
+static int	lane_occluded(const t_scene *scene, const t_shadow_tile *tile,
+		t_ray ray)
+{
+	const t_accel	*accel;
+	t_hit			hit;
+	int				obj;
+	int				i;
+
+	accel = scene->accel;
+	hit.t = -1.0;
+	if (tile->planes && trace_planes(scene, ray, &hit))
+		return (1);
+	i = accel->num_objects - tile->num_others - 1;
+	while (++i < accel->num_objects)
+	{
+		obj = tile->casters[i];
+		if (!bound_cone_rejects(&accel->light_cones[obj], ray.direction)
+			&& trace_object(scene, ray, &hit, obj))
+			return (1);
+	}
+	return (0);
+}
+
+/*
+** Trace a tile's shadow rays in packets against the objects its cull
+** kept, and record in lit which of its pixels the light reaches
+*/
+void	shadow_tile_trace(const t_scene *scene, const t_hit *hits,
+		const t_shadow_tile *tile, int *lit)
+{
+	t_shadow_packet	packet;
+	int				l;
+
+	packet.first = 0;
+	while (packet.first < tile->count)
+	{
+		packet_load(scene, hits, tile, &packet);
+		packet_spheres(scene, tile, &packet);
+		l = -1;
+		while (++l < packet.count)
+			lit[tile->pixels[packet.first + l]] = packet.open[l]
+				&& !lane_occluded(scene, tile, packet.rays[l]);
+		packet.first += SHADOW_PACKET;
+	}
+}
@@ -0,0 +1,113 @@
+#include "../../includes/minirt_app.h"
+#include "../../includes/accel.h"
+
+/*
+** Inward normals of the view frustum's planes through the camera: the
+** four sides, widened by a pixel so sub-pixel samples stay inside, and
+** the plane facing forward
+*/
+static void	frustum_planes(const t_view *view, t_vec3 *normal)
+{
+	double	half_w;
+	double	half_h;
+
+	half_w = (WIDTH / 2.0 + 1.0) * view->pixel_scale;
+	half_h = (HEIGHT / 2.0 + 1.0) * view->pixel_scale;
+	normal[0] = vec3_sub(vec3_mult(view->forward, half_w), view->right);
+	normal[1] = vec3_add(vec3_mult(view->forward, half_w), view->right);
+	normal[2] = vec3_sub(vec3_mult(view->forward, half_h), view->up);
+	normal[3] = vec3_add(vec3_mult(view->forward, half_h), view->up);
+	normal[4] = view->forward;
+}
+
+/*
+** Check whether part of the box lies inside all frustum planes
+** (conservative: boxes near a frustum corner may be kept)
+*/
+static int	box_in_frustum(const t_aabb *box, t_point3 origin,
+		const t_vec3 *normal)
+{
+	t_vec3	center;
+	t_vec3	extent;
+	int		i;
+
+	center = vec3_sub(vec3_mult(vec3_add(box->min, box->max), 0.5), origin);
+	extent = vec3_mult(vec3_sub(box->max, box->min), 0.5);
+	i = -1;
+	while (++i < 5)
+	{
+		if (vec3_dot(center, normal[i]) + extent.x * fabs(normal[i].x)
+			+ extent.y * fabs(normal[i].y) + extent.z * fabs(normal[i].z)
+			< 0.0)
+			return (0);
+	}
+	return (1);
+}
+
+/*
+** Distance from p to the nearest point of the box; a ray from p cannot
+** hit the box's object any closer
+*/
+static double	box_distance(const t_aabb *box, t_point3 p)
+{
+	t_vec3	d;
+
+	d.x = fmax(fmax(box->min.x - p.x, p.x - box->max.x), 0.0);
+	d.y = fmax(fmax(box->min.y - p.y, p.y - box->max.y), 0.0);
+	d.z = fmax(fmax(box->min.z - p.z, p.z - box->max.z), 0.0);
+	return (vec3_length(d));
+}
+
+/*
+** Keep the bounded objects whose boxes meet the view frustum, with the
+** distance to their boxes
+*/
+static void	view_list_build(t_accel *accel, const t_view *view)
+{
+	t_vec3	normal[5];
+	int		obj;
+	int		i;
+
+	frustum_planes(view, normal);
+	accel->view.count = 0;
+	i = -1;
+	while (++i < accel->num_bounded)
+	{
+		obj = accel->bounded[i];
+		if (!box_in_frustum(&accel->bounds[obj], view->origin, normal))
+			continue ;
+		accel->view.items[accel->view.count].near
+			= box_distance(&accel->bounds[obj], view->origin);
+		accel->view.items[accel->view.count++].object = obj;
+	}
+}
+
+/*
+** Per-frame pass: refresh the camera's and the light's origin terms, the
+** light's bounding cones and, if stale, the caster lists, the light
+** cache and the shadow map; for the flat
+** list, also keep the objects in the view frustum, sort them front to
+** back from the camera and bin them into screen tiles
+** Called before rays are traced with a new camera, light or objects
+*/
+void	accel_view_update(t_scene *scene)
+{
+	t_accel	*accel;
+	t_view	view;
+
+	accel = scene->accel;
+	if (!accel)
+		return ;
+	origin_cache_update(&accel->camera, scene, scene->camera.position);
+	origin_cache_update(&accel->light, scene, scene->light.position);
+	light_cones_update(accel, scene);
+	caster_lists_update(accel, scene);
+	light_cache_update(&accel->light_cache, scene);
+	shadow_map_update(&accel->shadow_map, scene);
+	if (accel->mode != ACCEL_NONE)
+		return ;
+	view = camera_view(scene);
+	view_list_build(accel, &view);
+	view_sort(&accel->view);
+	view_tiles_build(accel, &view);
+}
@@ -0,0 +1,57 @@
+#include "../../includes/minirt_app.h"
+#include "../../includes/accel.h"
+
+/*
+** Merge the sorted runs src[run[0], run[1]) and src[run[1], run[2])
+** into dst, keeping equal distances in their original order
+*/
+static void	merge_runs(const t_view_item *src, t_view_item *dst,
+		const int *run)
+{
+	int	i;
+	int	j;
+	int	k;
+
+	i = run[0];
+	j = run[1];
+	k = run[0];
+	while (k < run[2])
+	{
+		if (j >= run[2] || (i < run[1] && src[i].near <= src[j].near))
+			dst[k++] = src[i++];
+		else
+			dst[k++] = src[j++];
+	}
+}
+
+/*
+** Stable bottom-up merge sort of the view list by distance, ping-ponging
+** between items and scratch
+*/
+void	view_sort(t_view_list *view)
+{
+	t_view_item	*tmp;
+	int			run[3];
+	int			width;
+
+	width = 1;
+	while (width < view->count)
+	{
+		run[0] = 0;
+		while (run[0] < view->count)
+		{
+			run[1] = run[0] + width;
+			if (run[1] > view->count)
+				run[1] = view->count;
+			run[2] = run[0] + 2 * width;
+			if (run[2] > view->count)
+				run[2] = view->count;
+			merge_runs(view->items, view->scratch, run);
+			run[0] = run[2];
+		}
+		tmp = view->items;
+		view->items = view->scratch;
+		view->scratch = tmp;
+		width *= 2;
+	}
+}
@@ -0,0 +1,146 @@
+#include "../../includes/minirt_app.h"
+#include "../../includes/accel.h"
+
+/*
+** Screen-space extent of the box's corners around the image centre, in
+** units of the camera's tangent plane
+** Returns 0 if a corner lies behind the camera plane
+*/
+static int	project_corners(const t_view *cam, const t_aabb *box,
+		double *range)
+{
+	t_vec3	p;
+	double	depth;
+	int		i;
+
+	i = -1;
+	while (++i < 8)
+	{
+		p = box->min;
+		if (i & 1)
+			p.x = box->max.x;
+		if (i & 2)
+			p.y = box->max.y;
+		if (i & 4)
+			p.z = box->max.z;
+		p = vec3_sub(p, cam->origin);
+		depth = vec3_dot(p, cam->forward);
+		if (depth < EPSILON)
+			return (0);
+		range[0] = fmin(range[0], vec3_dot(p, cam->right) / depth);
+		range[2] = fmax(range[2], vec3_dot(p, cam->right) / depth);
+		range[1] = fmin(range[1], -vec3_dot(p, cam->up) / depth);
+		range[3] = fmax(range[3], -vec3_dot(p, cam->up) / depth);
+	}
+	return (1);
+}
+
+/*
+** Tiles covered by the projection of the box, widened by a pixel so
+** sub-pixel samples are covered; boxes reaching behind the camera plane
+** cover every tile. rect is x0, y0, x1, y1 in tiles, inclusive
+*/
+static void	tile_rect(const t_view *cam, const t_aabb *box, int *rect)
+{
+	double	range[4];
+
+	range[0] = DBL_MAX;
+	range[1] = DBL_MAX;
+	range[2] = -DBL_MAX;
+	range[3] = -DBL_MAX;
+	rect[0] = 0;
+	rect[1] = 0;
+	rect[2] = TILES_X - 1;
+	rect[3] = TILES_Y - 1;
+	if (!project_corners(cam, box, range))
+		return ;
+	rect[0] = view_tile_coord(range[0] / cam->pixel_scale + WIDTH / 2.0
+			- 1.0, TILES_X);
+	rect[1] = view_tile_coord(range[1] / cam->pixel_scale + HEIGHT / 2.0
+			- 1.0, TILES_Y);
+	rect[2] = view_tile_coord(range[2] / cam->pixel_scale + WIDTH / 2.0
+			+ 1.0, TILES_X);
+	rect[3] = view_tile_coord(range[3] / cam->pixel_scale + HEIGHT / 2.0
+			+ 1.0, TILES_Y);
+}
+
+/*
+** Visit every tile of a view-list item's rectangle: count it into
+** tile_start[t + 1], or, with fill set, append the item at the tile cursor
+*/
+static void	insert_item(t_tile_bins *bins, const int *rect, int item,
+		int fill)
+{
+	int	x;
+	int	y;
+	int	tile;
+
+	y = rect[1] - 1;
+	while (++y <= rect[3])
+	{
+		x = rect[0] - 1;
+		while (++x <= rect[2])
+		{
+			tile = y * TILES_X + x;
+			if (fill)
+				bins->tile_items[bins->tile_start[tile]++] = item;
+			else
+				bins->tile_start[tile + 1]++;
+		}
+	}
+}
+
+/*
+** Allocate the tile offsets on first use and grow the item array to the
+** counted number of entries
+*/
+static void	tiles_reserve(t_tile_bins *bins)
+{
+	if (!bins->tile_start)
+		bins->tile_start = ft_calloc(TILES_X * TILES_Y + 1, sizeof(int));
+	if (!bins->tile_start)
+		error_exit(ERR_MEMORY);
+	if (bins->tile_start[TILES_X * TILES_Y] < bins->capacity)
+		return ;
+	free(bins->tile_items);
+	bins->capacity = bins->tile_start[TILES_X * TILES_Y] + 1;
+	bins->tile_items = malloc(sizeof(int) * bins->capacity);
+	if (!bins->tile_items)
+		error_exit(ERR_MEMORY);
+}
+
+/*
+** Bin the view list into screen tiles, like a rasteriser's binning step:
+** project each item's box once, count, prefix-sum and fill the tiles in
+** view-list order, so every tile list stays front to back
+** The fill pass advances each tile_start to the next tile's start, so
+** the offsets are shifted back by one tile afterwards
+*/
+void	view_tiles_build(t_accel *accel, const t_view *camera)
+{
+	t_tile_bins	*bins;
+	int			i;
+
+	bins = &accel->tiles;
+	bins->camera = *camera;
+	tiles_reserve(bins);
+	ft_bzero(bins->tile_start, sizeof(int) * (TILES_X * TILES_Y + 1));
+	i = -1;
+	while (++i < accel->view.count)
+	{
+		tile_rect(camera, &accel->bounds[accel->view.items[i].object],
+			accel->view.items[i].rect);
+		insert_item(bins, accel->view.items[i].rect, i, FALSE);
+	}
+	i = -1;
+	while (++i < TILES_X * TILES_Y)
+		bins->tile_start[i + 1] += bins->tile_start[i];
+	tiles_reserve(bins);
+	i = -1;
+	while (++i < accel->view.count)
+		insert_item(bins, accel->view.items[i].rect, i, TRUE);
+	i = TILES_X * TILES_Y;
+	while (--i > 0)
+		bins->tile_start[i] = bins->tile_start[i - 1];
+	bins->tile_start[0] = 0;
+}
@@ -0,0 +1,93 @@
+#include "../../includes/minirt_app.h"
+#include "../../includes/accel.h"
+
+/*
+** Tile coordinate of a continuous pixel coordinate (integer values are
+** pixel centres), clamped to the screen
+*/
+int	view_tile_coord(double pixel, int tiles)
+{
+	double	tile;
+
+	tile = floor((pixel + 0.5) / TILE_SIZE);
+	if (tile < 0.0)
+		return (0);
+	if (tile >= tiles)
+		return (tiles - 1);
+	return ((int)tile);
+}
+
+/*
+** Screen tile a primary ray passes through, from its direction in the
+** camera basis the tiles were built for
+*/
+static int	ray_tile(const t_tile_bins *bins, t_ray ray)
+{
+	double	depth;
+	int		x;
+	int		y;
+
+	depth = vec3_dot(ray.direction, bins->camera.forward)
+		* bins->camera.pixel_scale;
+	x = view_tile_coord(vec3_dot(ray.direction, bins->camera.right) / depth
+			+ WIDTH / 2.0, TILES_X);
+	y = view_tile_coord(HEIGHT / 2.0
+			- vec3_dot(ray.direction, bins->camera.up) / depth, TILES_Y);
+	return (y * TILES_X + x);
+}
+
+/*
+** Test the planes, then the objects binned in the ray's tile front to
+** back; as soon as an object's box is farther than the closest hit, so
+** are all the following ones
+** Returns 1 if any hit, 0 if no hit
+*/
+static int	trace_view(const t_scene *scene, t_ray ray, t_hit *closest_hit)
+{
+	const t_tile_bins	*bins;
+	const t_view_item	*item;
+	t_vec3				inv_dir;
+	int					hit_found;
+	int					tile;
+	int					k;
+
+	bins = &scene->accel->tiles;
+	inv_dir = ray_inverse_direction(ray);
+	hit_found = trace_planes(scene, ray, closest_hit);
+	tile = ray_tile(bins, ray);
+	k = bins->tile_start[tile] - 1;
+	while (++k < bins->tile_start[tile + 1])
+	{
+		item = &scene->accel->view.items[bins->tile_items[k]];
+		if (item->near > hit_tmax(closest_hit, ray.tmax))
+			break ;
+		if (aabb_hit(&scene->accel->bounds[item->object], &ray, inv_dir,
+				hit_tmax(closest_hit, ray.tmax))
+			&& trace_object(scene, ray, closest_hit, item->object))
+			hit_found = 1;
+	}
+	return (hit_found);
+}
+
+/*
+** Trace a primary ray (from the camera, through the image), starting at
+** the object the caller's previous primary ray hit (hints may be NULL);
+** with the flat list only the objects binned in the ray's screen tile
+** are tested, nearest first
+** Returns 1 if any hit, 0 if no hit
+*/
+int	trace_primary(const t_scene *scene, t_ray ray, t_hit *closest_hit,
+		t_hints *hints)
+{
+	int	hit_found;
+
+	if (!scene->accel)
+		return (trace_objects(scene, ray, closest_hit));
+	hit_found = primary_hint_seed(hints, scene, &ray, closest_hit);
+	if (scene->accel->mode == ACCEL_NONE)
+		hit_found |= trace_view(scene, ray, closest_hit);
+	else
+		hit_found |= trace_seeded(scene, ray, closest_hit);
+	primary_hint_update(hints, scene, closest_hit, hit_found);
+	return (hit_found);
+}
@@ -0,0 +1,144 @@
+#include "../../includes/minirt_app.h"
+#include "../../includes/accel.h"
+
+/*
+** Quantise one bound inside [origin, origin + 255 * scale], rounding
+** outwards so the decoded box always contains the real one
+*/
+static unsigned char	quantize(double value, float origin, float scale,
+		int round_up)
+{
+	double	q;
+
+	q = (value - origin) / scale;
+	if (round_up)
+		q = ceil(q);
+	else
+		q = floor(q);
+	if (q < 0.0)
+		return (0);
+	if (q > 255.0)
+		return (255);
+	return ((unsigned char)q);
+}
+
+/*
+** Fit the node's origin and scale on one axis around its n child boxes
+** and quantise the children's bounds; the padding absorbs the rounding
+** of the single-precision decode and slab test
+*/
+static void	quantize_axis(t_wide_node *wide, const t_aabb *box, int n,
+		int axis)
+{
+	double	lo;
+	double	hi;
+	double	pad;
+	int		i;
+
+	lo = DBL_MAX;
+	hi = -DBL_MAX;
+	i = -1;
+	while (++i < n)
+	{
+		lo = fmin(lo, vec3_component(box[i].min, axis));
+		hi = fmax(hi, vec3_component(box[i].max, axis));
+	}
+	pad = (fabs(lo) + fabs(hi)) * WBVH_PAD + WBVH_PAD;
+	wide->origin[axis] = lo - 2.0 * pad;
+	wide->scale[axis] = (hi + 2.0 * pad - wide->origin[axis]) / 255.0;
+	i = -1;
+	while (++i < n)
+	{
+		wide->lo[axis][i] = quantize(vec3_component(box[i].min, axis) - pad,
+				wide->origin[axis], wide->scale[axis], 0);
+		wide->hi[axis][i] = quantize(vec3_component(box[i].max, axis) + pad,
+				wide->origin[axis], wide->scale[axis], 1);
+	}
+}
+
+/*
+** Pick the binary nodes that become the children of a wide node: starting
+** from node itself, the interior slot with the largest box is replaced by
+** its two children until BVH_WIDTH slots are used or only leaves remain
+** Returns the number of slots, with their boxes in box
+*/
+static int	gather_children(const t_bvh *bvh, int node, int *slot,
+		t_aabb *box)
+{
+	int	n;
+	int	best;
+	int	i;
+
+	slot[0] = node;
+	n = 1;
+	while (n < BVH_WIDTH)
+	{
+		best = -1;
+		i = -1;
+		while (++i < n)
+			if (bvh->nodes[slot[i]].count == 0 && (best < 0
+					|| aabb_area(&bvh->nodes[slot[i]].box)
+					> aabb_area(&bvh->nodes[slot[best]].box)))
+				best = i;
+		if (best < 0)
+			break ;
+		slot[n++] = bvh->nodes[slot[best]].left + 1;
+		slot[best] = bvh->nodes[slot[best]].left;
+	}
+	i = -1;
+	while (++i < n)
+		box[i] = bvh->nodes[slot[i]].box;
+	return (n);
+}
+
+/*
+** Collapse the binary subtree below node into wide nodes (zeroed by
+** wbvh_build), depth first, checking that a traversal reaching depth
+** fits the stack
+** Returns the index of the wide node
+*/
+static int	collapse_node(t_accel *accel, int node, int depth)
+{
+	t_wide_node	*wide;
+	t_aabb		box[BVH_WIDTH];
+	int			slot[BVH_WIDTH];
+	int			n;
+	int			i;
+
+	if (BVH_WIDTH + (BVH_WIDTH - 1) * depth > WBVH_STACK_SIZE)
+		error_exit(ERR_BVH_STACK);
+	wide = &accel->wbvh.nodes[accel->wbvh.num_nodes++];
+	n = gather_children(&accel->bvh, node, slot, box);
+	i = -1;
+	while (++i < 3)
+		quantize_axis(wide, box, n, i);
+	i = -1;
+	while (++i < BVH_WIDTH)
+	{
+		wide->child[i] = -1;
+		if (i < n)
+			wide->count[i] = accel->bvh.nodes[slot[i]].count;
+		if (i < n && wide->count[i] > 0)
+			wide->child[i] = accel->bvh.nodes[slot[i]].first;
+		else if (i < n)
+			wide->child[i] = collapse_node(accel, slot[i], depth + 1);
+	}
+	return (wide - accel->wbvh.nodes);
+}
+
+/*
+** Rebuild the wide BVH from the current binary BVH; called after every
+** build, refit or rebuild of the binary tree, in time linear in its size
+** Each wide node consumes at least one binary interior node (or the root)
+*/
+void	wbvh_build(t_accel *accel)
+{
+	free(accel->wbvh.nodes);
+	accel->wbvh.nodes = ft_calloc(accel->bvh.num_nodes / 2 + 1,
+			sizeof(t_wide_node));
+	if (!accel->wbvh.nodes)
+		error_exit(ERR_MEMORY);
+	accel->wbvh.num_nodes = 0;
+	if (accel->bvh.num_prims > 0)
+		collapse_node(accel, 0, 0);
+}
@@ -0,0 +1,65 @@
+#include "../../includes/minirt_app.h"
+#include "../../includes/accel.h"
+
+/*
+** Lane-wise minimum and maximum, as a mask select so any SSE target
+** compiles them to a few vector instructions
+*/
+static t_v4f	v4_min(t_v4f a, t_v4f b)
+{
+	t_v4i	mask;
+
+	mask = a < b;
+	return ((t_v4f)((mask & (t_v4i)a) | (~mask & (t_v4i)b)));
+}
+
+static t_v4f	v4_max(t_v4f a, t_v4f b)
+{
+	t_v4i	mask;
+
+	mask = a > b;
+	return ((t_v4f)((mask & (t_v4i)a) | (~mask & (t_v4i)b)));
+}
+
+/*
+** Decode the four children's bounds on one axis and narrow their
+** [entry, exit] ranges by that slab
+*/
+static void	clip_axis(const t_wide_node *node, const t_wbvh_stack *stack,
+		int axis, t_v4f *range)
+{
+	const unsigned char	*lo;
+	const unsigned char	*hi;
+	float				base;
+	t_v4f				t0;
+	t_v4f				t1;
+
+	lo = node->lo[axis];
+	hi = node->hi[axis];
+	base = node->origin[axis] - stack->origin[axis];
+	t0 = (base + (t_v4f){lo[0], lo[1], lo[2], lo[3]} * node->scale[axis])
+		* stack->inv_dir[axis];
+	t1 = (base + (t_v4f){hi[0], hi[1], hi[2], hi[3]} * node->scale[axis])
+		* stack->inv_dir[axis];
+	range[0] = v4_max(range[0], v4_min(t0, t1));
+	range[1] = v4_min(range[1], v4_max(t0, t1));
+}
+
+/*
+** Slab test of the ray against all child boxes of a wide node at once,
+** clipped to [0, tmax]; entry receives where the ray enters each box
+** Returns a lane mask, all bits set for the boxes the ray enters
+*/
+t_v4i	wbvh_node_test(const t_wide_node *node, const t_wbvh_stack *stack,
+		t_v4f *entry)
+{
+	t_v4f	range[2];
+
+	range[0] = (t_v4f){0.0f, 0.0f, 0.0f, 0.0f};
+	range[1] = range[0] + stack->tmax;
+	clip_axis(node, stack, 0, range);
+	clip_axis(node, stack, 1, range);
+	clip_axis(node, stack, 2, range);
+	*entry = range[0];
+	return (range[0] <= range[1]);
+}
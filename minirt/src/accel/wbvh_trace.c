@@ -0,0 +1,110 @@
+#include "../../includes/minirt_app.h"
+#include "../../includes/accel.h"
+
+/*
+** Convert the ray and its current tmax to single precision for the
+** node tests
+*/
+static void	stack_init(t_wbvh_stack *stack, t_ray ray, double tmax)
+{
+	t_vec3	inv_dir;
+
+	inv_dir = ray_inverse_direction(ray);
+	stack->origin[0] = ray.origin.x;
+	stack->origin[1] = ray.origin.y;
+	stack->origin[2] = ray.origin.z;
+	stack->inv_dir[0] = inv_dir.x;
+	stack->inv_dir[1] = inv_dir.y;
+	stack->inv_dir[2] = inv_dir.z;
+	stack->tmax = fmin(tmax, WBVH_FAR);
+	stack->size = 0;
+}
+
+/*
+** Insertion-sort the used children the ray enters by entry distance,
+** farthest first
+** Returns the number of children in order
+*/
+static int	sort_hits(const t_wide_node *node, t_v4i hit, t_v4f entry,
+		int *order)
+{
+	int	n;
+	int	i;
+	int	j;
+
+	n = 0;
+	i = -1;
+	while (++i < BVH_WIDTH)
+	{
+		if (!hit[i] || node->child[i] < 0)
+			continue ;
+		j = n++;
+		while (j > 0 && entry[order[j - 1]] < entry[i])
+		{
+			order[j] = order[j - 1];
+			j--;
+		}
+		order[j] = i;
+	}
+	return (n);
+}
+
+/*
+** Push the children the ray enters, farthest first, so they are popped
+** front to back and near hits cull the far children; wbvh_build checks
+** that the tree fits the stack, so overflowing it is a bug
+*/
+static void	push_children(const t_wide_node *node, t_wbvh_stack *stack)
+{
+	t_v4f	entry;
+	t_v4i	hit;
+	int		order[BVH_WIDTH];
+	int		n;
+	int		i;
+
+	hit = wbvh_node_test(node, stack, &entry);
+	n = sort_hits(node, hit, entry, order);
+	i = -1;
+	if (stack->size + n > WBVH_STACK_SIZE)
+		error_exit(ERR_BVH_STACK);
+	while (++i < n)
+	{
+		stack->child[stack->size] = node->child[order[i]];
+		stack->count[stack->size] = node->count[order[i]];
+		stack->entry[stack->size++] = entry[order[i]];
+	}
+}
+
+/*
+** Walk the wide BVH front to back; each popped wide node tests all its
+** child boxes with one SIMD slab test, leaves are tested as in the
+** binary BVH
+** Returns 1 if any hit, 0 if no hit
+*/
+int	wbvh_trace(const t_scene *scene, t_ray ray, t_hit *closest_hit)
+{
+	const t_wbvh	*wbvh;
+	t_wbvh_stack	stack;
+	t_bvh_node		leaf;
+	int				hit_found;
+
+	wbvh = &scene->accel->wbvh;
+	hit_found = 0;
+	stack_init(&stack, ray, hit_tmax(closest_hit, ray.tmax));
+	if (wbvh->num_nodes > 0)
+		push_children(&wbvh->nodes[0], &stack);
+	while (stack.size > 0)
+	{
+		stack.size--;
+		stack.tmax = fmin(hit_tmax(closest_hit, ray.tmax), WBVH_FAR);
+		if (stack.entry[stack.size] > stack.tmax)
+			continue ;
+		leaf.first = stack.child[stack.size];
+		leaf.count = stack.count[stack.size];
+		if (leaf.count == 0)
+			push_children(&wbvh->nodes[leaf.first], &stack);
+		else if (bvh_trace_leaf(scene, &leaf, ray, closest_hit))
+			hit_found = 1;
+	}
+	return (hit_found);
+}
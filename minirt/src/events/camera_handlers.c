@@ -3,7 +3,7 @@
 #include "../../includes/scene_math.h"
 #include <stdio.h>
 
-void	handle_camera_movement(int keycode, t_scene *scene)
+int	handle_camera_movement(int keycode, t_scene *scene)
 {
 	t_vec3	right;
 
@@ -27,9 +27,12 @@ void	handle_camera_movement(int keycode, t_scene *scene)
 		scene_translate_camera(scene, vec3_create(0, -0.5, 0));
 	else if (keycode == KEY_E || keycode == KEY_E_MAC)
 		scene_translate_camera(scene, vec3_create(0, 0.5, 0));
+	else
+		return (0);
+	return (1);
 }
 
-void	handle_camera_rotation(int keycode, t_scene *scene)
+int	handle_camera_rotation(int keycode, t_scene *scene)
 {
 	t_vec3	forward;
 	t_vec3	right;
@@ -40,7 +43,7 @@ void	handle_camera_rotation(int keycode, t_scene *scene)
 	if (!(keycode == KEY_I || keycode == KEY_I_MAC || keycode == KEY_K
 			|| keycode == KEY_K_MAC || keycode == KEY_J || keycode == KEY_J_MAC
 			|| keycode == KEY_L || keycode == KEY_L_MAC))
-		return ;
+		return (0);
 	forward = vec3_normalize(scene->camera.orientation);
 	world_up = vec3_create(0, 1, 0);
 	right = vec3_normalize(vec3_cross(forward, world_up));
@@ -59,4 +62,19 @@ void	handle_camera_rotation(int keycode, t_scene *scene)
 		scene->camera.orientation = vec3_add(vec3_mult(forward, cos(angle)),
 				vec3_mult(right, sin(angle)));
 	scene->camera.orientation = vec3_normalize(scene->camera.orientation);
+	return (1);
+}
+
+/*
+** Move or rotate the camera, reprojecting the last frame instead of
+** tracing it from scratch. Returns 1 if the key was a camera key.
+*/
+int	handle_camera_controls(int keycode, t_vars *vars, t_scene *scene)
+{
+	if (!handle_camera_movement(keycode, scene)
+		&& !handle_camera_rotation(keycode, scene))
+		return (0);
+	reproject_draw(vars, scene);
+	mlx_put_image_to_window(vars->mlx, vars->win, vars->img->img, 0, 0);
+	return (1);
 }
@@ -0,0 +1,63 @@
+#include "../../includes/events.h"
+#include "../../includes/minirt_app.h"
+#include "../../includes/scene_math.h"
+
+/*
+** Move the point light along the world axes
+** Returns 1 if the key was a light movement key
+*/
+static int	handle_light_movement(int keycode, t_scene *scene)
+{
+	t_vec3	delta;
+
+	delta = vec3_create(0, 0, 0);
+	if (keycode == KEY_Z || keycode == KEY_Z_MAC)
+		delta.x = -0.5;
+	else if (keycode == KEY_X || keycode == KEY_X_MAC)
+		delta.x = 0.5;
+	else if (keycode == KEY_C || keycode == KEY_C_MAC)
+		delta.y = -0.5;
+	else if (keycode == KEY_V || keycode == KEY_V_MAC)
+		delta.y = 0.5;
+	else if (keycode == KEY_B || keycode == KEY_B_MAC)
+		delta.z = -0.5;
+	else if (keycode == KEY_N || keycode == KEY_N_MAC)
+		delta.z = 0.5;
+	else
+		return (0);
+	scene->light.position = vec3_add(scene->light.position, delta);
+	return (1);
+}
+
+/*
+** Adjust light brightness and ambient ratio, clamped to [0, 1]
+** Returns 1 if the key was a light intensity key
+*/
+static int	handle_light_intensity(int keycode, t_scene *scene)
+{
+	if (keycode == KEY_Y || keycode == KEY_Y_MAC)
+		scene->light.brightness = fmin(1.0, scene->light.brightness + 0.1);
+	else if (keycode == KEY_H || keycode == KEY_H_MAC)
+		scene->light.brightness = fmax(0.0, scene->light.brightness - 0.1);
+	else if (keycode == KEY_U || keycode == KEY_U_MAC)
+		scene->ambient.ratio = fmin(1.0, scene->ambient.ratio + 0.1);
+	else if (keycode == KEY_M || keycode == KEY_M_MAC)
+		scene->ambient.ratio = fmax(0.0, scene->ambient.ratio - 0.1);
+	else
+		return (0);
+	return (1);
+}
+
+/*
+** Handle lighting-only edits without re-tracing primary rays
+** Returns 1 if the key changed the lighting and the image was relit
+*/
+int	handle_light_controls(int keycode, t_vars *vars, t_scene *scene)
+{
+	if (!handle_light_movement(keycode, scene)
+		&& !handle_light_intensity(keycode, scene))
+		return (0);
+	relight_image(vars, scene);
+	mlx_put_image_to_window(vars->mlx, vars->win, vars->img->img, 0, 0);
+	return (1);
+}
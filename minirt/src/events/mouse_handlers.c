@@ -0,0 +1,32 @@
+#include "../../includes/events.h"
+#include "../../includes/minirt_app.h"
+
+/*
+** Recomposite the highlight after the selection changed
+*/
+void	redraw_selection(t_vars *vars)
+{
+	if (!vars->gbuf.valid)
+		return ;
+	composite_image(vars);
+	mlx_put_image_to_window(vars->mlx, vars->win, vars->img->img, 0, 0);
+}
+
+/*
+** Pick the object under the cursor with a lookup in the object-ID buffer
+*/
+int	mouse_handler(int button, int x, int y, t_vars *vars)
+{
+	int	id;
+
+	if (button != MOUSE_LEFT || !vars->gbuf.valid)
+		return (0);
+	if (x < 0 || x >= WIDTH || y < 0 || y >= HEIGHT)
+		return (0);
+	id = vars->gbuf.ids[y * WIDTH + x];
+	if (id < 0 || id == g_selected_obj)
+		return (0);
+	g_selected_obj = id;
+	redraw_selection(vars);
+	return (0);
+}
@@ -5,14 +5,31 @@
 
 extern int	g_selected_obj;
 
+/*
+** Cycle the selected object; only the highlight is recomposited
+** Returns 1 if the key was a selection key
+*/
+int	handle_object_selection(int keycode, t_vars *vars, t_scene *scene)
+{
+	if (keycode == KEY_P || keycode == KEY_P_MAC)
+	{
+		if (g_selected_obj < scene->num_objects - 1)
+			g_selected_obj++;
+	}
+	else if (keycode == KEY_O || keycode == KEY_O_MAC)
+	{
+		if (g_selected_obj > 0)
+			g_selected_obj--;
+	}
+	else
+		return (0);
+	redraw_selection(vars);
+	return (1);
+}
+
 void	handle_object_transforms(int keycode, t_scene *scene)
 {
-	if ((keycode == KEY_P || keycode == KEY_P_MAC)
-		&& g_selected_obj < scene->num_objects - 1)
-		g_selected_obj++;
-	else if ((keycode == KEY_O || keycode == KEY_O_MAC) && g_selected_obj > 0)
-		g_selected_obj--;
-	else if (keycode == KEY_LEFT || keycode == KEY_LEFT_MAC)
+	if (keycode == KEY_LEFT || keycode == KEY_LEFT_MAC)
 		scene_translate_object(scene, g_selected_obj, vec3_create(-0.3, 0, 0));
 	else if (keycode == KEY_RIGHT || keycode == KEY_RIGHT_MAC)
 		scene_translate_object(scene, g_selected_obj, vec3_create(0.3, 0, 0));
@@ -17,6 +17,19 @@ int	close_window_esc(int keycode, t_vars *vars)
 	return (0);
 }
 
+/*
+** Replace a reprojected image with a full render once the camera stops
+*/
+int	idle_handler(t_vars *vars)
+{
+	if (!g_scene || !vars->gbuf.stale
+		|| time_now_ms() - vars->gbuf.last_move_ms < REPROJ_IDLE_MS)
+		return (0);
+	main_draw(vars, g_scene);
+	mlx_put_image_to_window(vars->mlx, vars->win, vars->img->img, 0, 0);
+	return (0);
+}
+
 void	print_controls_help(void)
 {
 	printf("\n=== MiniRT Transform Controls ===\n");
@@ -29,10 +42,17 @@ void	print_controls_help(void)
 	printf("  J/L - Look left/right\n");
 	printf("\nOBJECT CONTROLS:\n");
 	printf("  P/O - Select object (next/previous)\n");
+	printf("  Left click - Select the object under the cursor\n");
 	printf("  Arrow keys - Move object (left/right/up/down)\n");
 	printf("  +/- - Scale object up/down\n");
 	printf("  R/F - Rotate object around X-axis (forward/reverse)\n");
 	printf("  T/G - Rotate object around Y-axis (forward/reverse)\n");
+	printf("\nLIGHT CONTROLS (relit without re-tracing):\n");
+	printf("  Z/X - Move light along X-axis\n");
+	printf("  C/V - Move light along Y-axis\n");
+	printf("  B/N - Move light along Z-axis\n");
+	printf("  Y/H - Light brightness up/down\n");
+	printf("  U/M - Ambient ratio up/down\n");
 	printf("\nOTHER:\n");
 	printf("  SPACE - Show this help\n");
 	printf("  ESC - Exit\n");
@@ -1,6 +1,7 @@
 #include "../includes/events.h"
 #include "../includes/minirt_app.h"
 #include "../includes/render_utils.h"
+#include "../includes/accel.h"
 #include <stdio.h>
 
 t_scene	*g_scene = NULL;
@@ -97,25 +98,32 @@ static void	init_mlx_and_window(t_vars *vars)
 	if (!vars->win)
 		error_exit("Error: Window creation failed\n");
 	create_image(vars);
+	gbuffer_init(&vars->gbuf);
+	hints_init(&vars->hints);
 }
 
 int	main(int argc, char **argv)
 {
 	t_scene	*scene;
 	t_vars	vars;
+	char	*scene_file;
 
-	if (argc != 2)
-		error_exit(ERR_ARGS);
-	scene = parse_scene_file(argv[1]);
+	scene_file = parse_options(argc, argv, &vars.opts);
+	if (!scene_file)
+		error_exit(ERR_USAGE);
+	scene = parse_scene_file(scene_file);
 	if (!scene)
 		error_exit(ERR_SCENE);
 	print_scene_info(scene);
+	accel_build(scene, &vars.opts);
 	init_mlx_and_window(&vars);
 	set_scene_for_transforms(scene);
-	main_draw(&vars, scene);
+	draw_first_frame(&vars, scene);
 	mlx_hooks(&vars);
 	mlx_put_image_to_window(vars.mlx, vars.win, vars.img->img, 0, 0);
 	mlx_loop(vars.mlx);
-	free(scene);
+	gbuffer_free(&vars.gbuf);
+	accel_free(scene);
+	free_scene(scene);
 	return (0);
 }
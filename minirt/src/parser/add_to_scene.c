@@ -1,13 +1,38 @@
 #include "../includes/minirt_app.h"
 
-int	add_object_to_scene(t_scene *scene, int type, void *object_data)
+/*
+** Make room for one more object, doubling the array when it is full
+** Returns FALSE if the allocation fails
+*/
+static int	grow_objects(t_scene *scene)
 {
-	if (scene->num_objects >= MAX_OBJECTS)
+	t_object	*objects;
+	int			capacity;
+
+	if (scene->num_objects < scene->max_objects)
+		return (TRUE);
+	capacity = scene->max_objects * 2;
+	if (capacity < OBJECT_CAPACITY)
+		capacity = OBJECT_CAPACITY;
+	objects = malloc(sizeof(t_object) * capacity);
+	if (!objects)
 	{
-		printf("Error: Maximum number of objects reached (%d)\n",
-			MAX_OBJECTS);
+		printf("Error: Out of memory for %d objects\n", capacity);
 		return (FALSE);
 	}
+	if (scene->objects)
+		ft_memcpy(objects, scene->objects,
+			sizeof(t_object) * scene->num_objects);
+	free(scene->objects);
+	scene->objects = objects;
+	scene->max_objects = capacity;
+	return (TRUE);
+}
+
+int	add_object_to_scene(t_scene *scene, int type, void *object_data)
+{
+	if (!grow_objects(scene))
+		return (FALSE);
 	scene->objects[scene->num_objects].type = type;
 	if (type == SPHERE)
 		scene->objects[scene->num_objects].data.sphere = *(t_sphere *)object_data;
@@ -23,6 +48,18 @@ int	add_object_to_scene(t_scene *scene, int type, void *object_data)
 		printf("Error: Unknown object type %d\n", type);
 		return (FALSE);
 	}
+	object_update_bound(&scene->objects[scene->num_objects]);
 	scene->num_objects++;
 	return (TRUE);
 }
+
+/*
+** Release a scene and its object array
+*/
+void	free_scene(t_scene *scene)
+{
+	if (!scene)
+		return ;
+	free(scene->objects);
+	free(scene);
+}
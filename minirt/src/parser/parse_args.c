@@ -0,0 +1,78 @@
+#include "../includes/minirt_app.h"
+#include "../includes/options.h"
+
+/*
+** Apply one command line flag
+** Returns 1 if the flag is known, 0 otherwise
+*/
+static int	parse_flag(char *arg, t_options *opts)
+{
+	if (ft_strncmp(arg, "--subsample", 12) == 0)
+		opts->subsample = TRUE;
+	else if (ft_strncmp(arg, "--quality-check", 16) == 0)
+		opts->quality_check = TRUE;
+	else if (ft_strncmp(arg, "--aa", 5) == 0)
+		opts->antialias = TRUE;
+	else if (ft_strncmp(arg, "--stats", 8) == 0)
+		opts->stats = TRUE;
+	else if (ft_strncmp(arg, "--light-cache", 14) == 0)
+		opts->light_cache = TRUE;
+	else if (ft_strncmp(arg, "--sort-rays", 12) == 0)
+		opts->sort_rays = TRUE;
+	else if (ft_strncmp(arg, "--bench-order", 14) == 0)
+		opts->bench_order = TRUE;
+	else
+		return (0);
+	return (1);
+}
+
+/*
+** Default options: full renders through the SAH BVH with ray-traced
+** shadows, in screen tiles, no extras
+*/
+static void	options_init(t_options *opts)
+{
+	opts->subsample = FALSE;
+	opts->quality_check = FALSE;
+	opts->antialias = FALSE;
+	opts->stats = FALSE;
+	opts->accel = ACCEL_BVH;
+	opts->bvh_build = BVH_BUILD_SAH;
+	opts->light_cache = FALSE;
+	opts->shadows = SHADOWS_RAY;
+	opts->shadow_res = SHADOW_MAP_RES;
+	opts->shadow_bias = SHADOW_MAP_BIAS;
+	opts->sort_rays = FALSE;
+	opts->order = ORDER_TILED;
+	opts->bench_order = FALSE;
+}
+
+/*
+** Parse the command line: one scene file plus optional render flags
+** Returns the scene file name, or NULL on invalid usage
+*/
+char	*parse_options(int argc, char **argv, t_options *opts)
+{
+	char	*scene_file;
+	int		known;
+	int		i;
+
+	options_init(opts);
+	scene_file = NULL;
+	i = 0;
+	while (++i < argc)
+	{
+		if (ft_strncmp(argv[i], "--", 2) == 0)
+		{
+			known = parse_value_flag(argv[i], argv[i + 1], opts);
+			if (known == 0 || (known < 0 && !parse_flag(argv[i], opts)))
+				return (NULL);
+			i += (known > 0);
+		}
+		else if (scene_file)
+			return (NULL);
+		else
+			scene_file = argv[i];
+	}
+	return (scene_file);
+}
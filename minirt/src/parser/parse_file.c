@@ -8,7 +8,10 @@ void	init_parser_and_scene(t_parser *parser, t_scene *scene)
 	parser->tokens = NULL;
 	parser->line_count = 0;
 	parser->has_camera = FALSE;
+	scene->objects = NULL;
 	scene->num_objects = 0;
+	scene->max_objects = 0;
+	scene->accel = NULL;
 	scene->camera.fov = 0.0;
 	scene->has_ambient = FALSE;
 	scene->has_light = FALSE;
@@ -34,14 +37,14 @@ int	validate_extension_and_permission(const char *filename, t_scene *scene)
 	if (!extension || ft_strncmp(extension, ".rt", 3) != 0)
 	{
 		printf(ERR_FILE_EXTENSION);
-		free(scene);
+		free_scene(scene);
 		return (-1);
 	}
 	fd = open(filename, O_RDONLY);
 	if (fd == -1)
 	{
 		printf(ERR_FILE_ACCESS, filename);
-		free(scene);
+		free_scene(scene);
 		return (-1);
 	}
 	return (fd);
@@ -150,13 +153,13 @@ t_scene	*parse_scene_file(char *filename)
 	{
 		result = process_scene_line(&parser, scene, line);
 		if (result == 0)
-			return (close(fd), free(scene), NULL);
+			return (close(fd), free_scene(scene), NULL);
 		line = get_next_line(fd);
 	}
 	close(fd);
 	if (parser.line_count == 0)
-		return (printf("Error: Empty file\n"), free(scene), NULL);
+		return (printf("Error: Empty file\n"), free_scene(scene), NULL);
 	if (!validate_scene(scene))
-		return (free(scene), NULL);
+		return (free_scene(scene), NULL);
 	return (scene);
 }
@@ -0,0 +1,21 @@
+#include "../includes/minirt_app.h"
+#include "../includes/options.h"
+
+/*
+** Select the pixel order of full frames from the --order value
+** Returns 1 if the value is known, 0 otherwise
+*/
+int	parse_order(char *value, t_options *opts)
+{
+	if (ft_strncmp(value, "scanline", 9) == 0)
+		opts->order = ORDER_SCANLINE;
+	else if (ft_strncmp(value, "tiled", 6) == 0)
+		opts->order = ORDER_TILED;
+	else if (ft_strncmp(value, "morton", 7) == 0)
+		opts->order = ORDER_MORTON;
+	else if (ft_strncmp(value, "hilbert", 8) == 0)
+		opts->order = ORDER_HILBERT;
+	else
+		return (0);
+	return (1);
+}
@@ -0,0 +1,104 @@
+#include "../includes/minirt_app.h"
+#include "../includes/options.h"
+
+/*
+** Select the structure for the bounded objects from the --accel value
+** Returns 1 if the value is known, 0 otherwise
+*/
+static int	parse_accel(char *value, t_options *opts)
+{
+	if (ft_strncmp(value, "none", 5) == 0)
+		opts->accel = ACCEL_NONE;
+	else if (ft_strncmp(value, "bvh", 4) == 0)
+		opts->accel = ACCEL_BVH;
+	else if (ft_strncmp(value, "grid", 5) == 0)
+		opts->accel = ACCEL_GRID;
+	else if (ft_strncmp(value, "wbvh", 5) == 0)
+		opts->accel = ACCEL_WBVH;
+	else if (ft_strncmp(value, "lazy", 5) == 0)
+		opts->accel = ACCEL_LAZY;
+	else
+		return (0);
+	return (1);
+}
+
+/*
+** Select the BVH builder from the --bvh-build value
+** Returns 1 if the value is known, 0 otherwise
+*/
+static int	parse_bvh_build(char *value, t_options *opts)
+{
+	if (ft_strncmp(value, "sah", 4) == 0)
+		opts->bvh_build = BVH_BUILD_SAH;
+	else if (ft_strncmp(value, "lbvh", 5) == 0)
+		opts->bvh_build = BVH_BUILD_LBVH;
+	else
+		return (0);
+	return (1);
+}
+
+/*
+** Select how shadows are found from the --shadows value
+** Returns 1 if the value is known, 0 otherwise
+*/
+static int	parse_shadows(char *value, t_options *opts)
+{
+	if (ft_strncmp(value, "ray", 4) == 0)
+		opts->shadows = SHADOWS_RAY;
+	else if (ft_strncmp(value, "map", 4) == 0)
+		opts->shadows = SHADOWS_MAP;
+	else
+		return (0);
+	return (1);
+}
+
+/*
+** Read the shadow map's face resolution (--shadow-res, a whole number of
+** texels within [SHADOW_MAP_MIN_RES, SHADOW_MAP_MAX_RES]) or its depth
+** bias in texels (--shadow-bias, not negative)
+** Returns 1 if the value is valid, 0 otherwise
+*/
+static int	parse_shadow_value(char *arg, char *value, t_options *opts)
+{
+	double	number;
+
+	if (!parse_double(value, &number))
+		return (0);
+	if (ft_strncmp(arg, "--shadow-bias", 14) == 0)
+	{
+		opts->shadow_bias = number;
+		return (number >= 0.0);
+	}
+	if (number < SHADOW_MAP_MIN_RES || number > SHADOW_MAP_MAX_RES
+		|| number != floor(number))
+		return (0);
+	opts->shadow_res = (int)number;
+	return (1);
+}
+
+/*
+** Apply a flag that takes a value, such as --accel bvh or --bvh-build sah
+** Returns 1 if the flag and value are known, 0 if the value is missing or
+** unknown, -1 if the flag takes no value
+*/
+int	parse_value_flag(char *arg, char *value, t_options *opts)
+{
+	if (ft_strncmp(arg, "--accel", 8) != 0
+		&& ft_strncmp(arg, "--bvh-build", 12) != 0
+		&& ft_strncmp(arg, "--shadows", 10) != 0
+		&& ft_strncmp(arg, "--shadow-res", 13) != 0
+		&& ft_strncmp(arg, "--shadow-bias", 14) != 0
+		&& ft_strncmp(arg, "--order", 8) != 0)
+		return (-1);
+	if (!value)
+		return (0);
+	if (ft_strncmp(arg, "--accel", 8) == 0)
+		return (parse_accel(value, opts));
+	if (ft_strncmp(arg, "--bvh-build", 12) == 0)
+		return (parse_bvh_build(value, opts));
+	if (ft_strncmp(arg, "--shadows", 10) == 0)
+		return (parse_shadows(value, opts));
+	if (ft_strncmp(arg, "--order", 8) == 0)
+		return (parse_order(value, opts));
+	return (parse_shadow_value(arg, value, opts));
+}
@@ -0,0 +1,124 @@
+#include "../../includes/minirt_app.h"
+#include "../../includes/gbuffer.h"
+#include "../../includes/stats.h"
+
+/*
+** Check whether neighbour j differs from pixel i by object or contrast
+*/
+static int	is_edge_between(const t_gbuffer *gbuf, int i, int j)
+{
+	int	shift;
+	int	diff;
+
+	if (gbuf->ids[i] != gbuf->ids[j])
+		return (1);
+	shift = 0;
+	while (shift <= 16)
+	{
+		diff = ((gbuf->colors[i] >> shift) & 0xFF)
+			- ((gbuf->colors[j] >> shift) & 0xFF);
+		if (diff > AA_CONTRAST || diff < -AA_CONTRAST)
+			return (1);
+		shift += 8;
+	}
+	return (0);
+}
+
+/*
+** Mark edge pixels into prev_ids (free scratch between frames)
+** Returns the number of edge pixels
+*/
+static int	mark_edges(t_gbuffer *gbuf)
+{
+	int	count;
+	int	x;
+	int	i;
+
+	count = 0;
+	i = 0;
+	while (i < WIDTH * HEIGHT)
+	{
+		x = i % WIDTH;
+		gbuf->prev_ids[i] = ((x > 0 && is_edge_between(gbuf, i, i - 1))
+				|| (x < WIDTH - 1 && is_edge_between(gbuf, i, i + 1))
+				|| (i >= WIDTH && is_edge_between(gbuf, i, i - WIDTH))
+				|| (i < WIDTH * (HEIGHT - 1)
+					&& is_edge_between(gbuf, i, i + WIDTH)));
+		count += gbuf->prev_ids[i];
+		i++;
+	}
+	return (count);
+}
+
+/*
+** Deterministic jitter in [0, 1) for stratified sampling
+*/
+static double	jitter(unsigned int seed)
+{
+	seed = seed * 1103515245u + 12345u;
+	seed ^= seed >> 16;
+	seed *= 2246822519u;
+	seed ^= seed >> 13;
+	return ((seed & 0xFFFF) / 65536.0);
+}
+
+/*
+** Average grid x grid jittered, stratified samples over pixel i
+*/
+static int	supersample_pixel(const t_scene *scene, int i, int grid,
+		t_hints *hints)
+{
+	int		sum[3];
+	int		color;
+	int		s;
+	double	sx;
+	double	sy;
+
+	ft_bzero(sum, sizeof(sum));
+	s = 0;
+	while (s < grid * grid)
+	{
+		sx = i % WIDTH - 0.5 + (s % grid + jitter(i * 31 + s)) / grid;
+		sy = i / WIDTH - 0.5 + (s / grid + jitter(i * 17 + s + 7)) / grid;
+		color = trace_ray(scene, generate_camera_ray_at(scene, sx, sy), hints);
+		sum[0] += (color >> 16) & 0xFF;
+		sum[1] += (color >> 8) & 0xFF;
+		sum[2] += color & 0xFF;
+		s++;
+	}
+	g_stats.aa_samples += grid * grid;
+	g_stats.aa_pixels++;
+	return (((sum[0] / s) << 16) | ((sum[1] / s) << 8) | (sum[2] / s));
+}
+
+/*
+** Adaptive anti-aliasing: after the one-sample pass, supersample only the
+** pixels on object-ID or color-contrast edges. The strata grid shrinks to
+** fit AA_SAMPLE_BUDGET, and edges past the budget keep their single sample.
+*/
+void	antialias_edges(t_vars *vars, t_scene *scene)
+{
+	long	budget;
+	int		edges;
+	int		grid;
+	int		i;
+
+	edges = mark_edges(&vars->gbuf);
+	if (edges == 0)
+		return ;
+	grid = AA_MAX_GRID;
+	while (grid > AA_MIN_GRID && (long)edges * grid * grid > AA_SAMPLE_BUDGET)
+		grid--;
+	budget = AA_SAMPLE_BUDGET;
+	i = 0;
+	while (i < WIDTH * HEIGHT && budget >= grid * grid)
+	{
+		if (vars->gbuf.prev_ids[i])
+		{
+			vars->gbuf.colors[i] = supersample_pixel(scene, i, grid,
+					&vars->hints);
+			budget -= grid * grid;
+		}
+		i++;
+	}
+}
@@ -0,0 +1,72 @@
+#include "../../includes/minirt_app.h"
+#include "../../includes/scene_math.h"
+#include <math.h>
+
+/*
+** Calculate camera basis vectors
+*/
+static void	calculate_camera_basis(const t_scene *scene, t_vec3 *right,
+		t_vec3 *up)
+{
+	t_vec3	forward;
+	t_vec3	world_up;
+
+	forward = vec3_normalize(scene->camera.orientation);
+	world_up = vec3_create(0, 1, 0);
+	*right = vec3_normalize(vec3_cross(forward, world_up));
+	*up = vec3_cross(*right, forward);
+}
+
+/*
+** Camera ray of a view through a (possibly fractional) pixel position;
+** integer coordinates are pixel centres
+** Callers generating many rays build the view once
+*/
+t_ray	view_ray(const t_view *view, double x, double y)
+{
+	t_ray	ray;
+	double	u;
+
+	ray.origin = view->origin;
+	ray.tmin = MIN_T;
+	ray.tmax = DBL_MAX;
+	u = (x - WIDTH / 2.0) * view->pixel_scale;
+	ray.direction = vec3_normalize(vec3_add(vec3_add(vec3_mult(view->right,
+						u), vec3_mult(view->up, (HEIGHT / 2.0 - y)
+						* view->pixel_scale)), view->forward));
+	return (ray);
+}
+
+/*
+** Generate a camera ray through a (possibly fractional) pixel position
+*/
+t_ray	generate_camera_ray_at(const t_scene *scene, double x, double y)
+{
+	t_view	view;
+
+	view = camera_view(scene);
+	return (view_ray(&view, x, y));
+}
+
+/*
+** Generate a camera ray for a given pixel (x, y)
+*/
+t_ray	generate_camera_ray(const t_scene *scene, int x, int y)
+{
+	return (generate_camera_ray_at(scene, x, y));
+}
+
+/*
+** Build the camera basis and pixel scale used by generate_camera_ray
+*/
+t_view	camera_view(const t_scene *scene)
+{
+	t_view	view;
+
+	view.origin = scene->camera.position;
+	view.forward = vec3_normalize(scene->camera.orientation);
+	calculate_camera_basis(scene, &view.right, &view.up);
+	view.pixel_scale = tan((scene->camera.fov * M_PI / 180.0) / 2.0)
+		/ (WIDTH / 2.0);
+	return (view);
+}
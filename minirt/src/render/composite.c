@@ -0,0 +1,76 @@
+#include "../../includes/events.h"
+#include "../../includes/minirt_app.h"
+#include "../../includes/constants.h"
+
+/*
+** Get the currently selected object index
+*/
+int	get_selected_object_index(void)
+{
+	return (g_selected_obj);
+}
+
+/*
+** Lighten one 8-bit channel towards white
+*/
+static int	lighten_channel(int channel)
+{
+	return (channel + (int)((255 - channel) * LIGHTENING_FACTOR));
+}
+
+/*
+** Apply selection highlighting to a packed pixel color, for colors that
+** are not the shade of a single hit
+*/
+static int	apply_selection_highlight(int color)
+{
+	return ((lighten_channel((color >> 16) & 0xFF) << 16)
+		| (lighten_channel((color >> 8) & 0xFF) << 8)
+		| lighten_channel(color & 0xFF));
+}
+
+/*
+** Highlighted color of pixel i, lightened before quantising as a traced
+** frame would be: its hit is re-shaded when the stored color is that
+** shade; interpolated, supersampled or reprojected colors are lightened
+** as stored
+*/
+static int	highlight_pixel(const t_gbuffer *gbuf, int i)
+{
+	t_color3	color;
+
+	if (g_scene && gbuf->hits[i].t >= 0.0)
+	{
+		color = calculate_lighting(g_scene, &gbuf->hits[i], gbuf->lit[i]);
+		if (color_to_int(color) == gbuf->colors[i])
+		{
+			color.x = color.x + (1.0 - color.x) * LIGHTENING_FACTOR;
+			color.y = color.y + (1.0 - color.y) * LIGHTENING_FACTOR;
+			color.z = color.z + (1.0 - color.z) * LIGHTENING_FACTOR;
+			return (color_to_int(color));
+		}
+	}
+	return (apply_selection_highlight(gbuf->colors[i]));
+}
+
+/*
+** Write the cached colors to the image, highlighting the selected object
+** Selection changes only need this pass, not a re-render
+*/
+void	composite_image(t_vars *vars)
+{
+	int	selected;
+	int	color;
+	int	i;
+
+	selected = get_selected_object_index();
+	i = 0;
+	while (i < WIDTH * HEIGHT)
+	{
+		color = vars->gbuf.colors[i];
+		if (vars->gbuf.ids[i] == selected)
+			color = highlight_pixel(&vars->gbuf, i);
+		put_pixel(vars, i % WIDTH, i / WIDTH, color);
+		i++;
+	}
+}
@@ -0,0 +1,36 @@
+#include "../includes/minirt_app.h"
+#include "../includes/scene_math.h"
+
+/*
+** Compute the quadratic coefficients for a ray-cylinder intersection;
+** cross(oc, axis) and c depend only on the ray origin and come with its
+** origin terms
+** Returns a t_quadratic struct with the coefficients a, b, c.
+*/
+t_quadratic	cylinder_quadratic_coeffs(const t_cylinder *cylinder,
+		const t_origin_terms *terms, t_ray ray)
+{
+	t_vec3		ray_axis_cross;
+	t_quadratic	q;
+
+	ray_axis_cross = vec3_cross(ray.direction, cylinder->axis);
+	q.a = vec3_dot(ray_axis_cross, ray_axis_cross);
+	q.b = 2.0 * vec3_dot(ray_axis_cross, terms->oc_axis);
+	q.c = terms->c;
+	return (q);
+}
+
+/*
+** Calculate the surface normal for a point on the cylinder.
+*/
+t_vec3	cylinder_surface_normal(const t_cylinder *cylinder, t_point3 point)
+{
+	double		m;
+	t_vec3		axis_projection;
+	t_point3	axis_point;
+
+	m = vec3_dot(vec3_sub(point, cylinder->center), cylinder->axis);
+	axis_projection = vec3_mult(cylinder->axis, m);
+	axis_point = vec3_add(cylinder->center, axis_projection);
+	return (vec3_normalize(vec3_sub(point, axis_point)));
+}
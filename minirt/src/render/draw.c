@@ -1,5 +1,7 @@
 #include "../../includes/minirt_app.h"
 #include "../../includes/scene_math.h"
+#include "../../includes/stats.h"
+#include "../../includes/accel.h"
 #include <stdio.h>
 
 /*
@@ -36,26 +38,74 @@ void	put_pixel(t_vars *vars, int x, int y, int color)
 }
 
 /*
-** Main draw loop for the scene
+** Trace one pixel, caching its hit, object ID, shadow state and color
+** in the G-buffer
 */
-void	main_draw(t_vars *vars, t_scene *scene)
+void	trace_pixel(t_vars *vars, t_scene *scene, int x, int y)
 {
 	t_ray	ray;
-	int		x;
-	int		y;
-	int		color;
+	t_hit	*hit;
+	int		i;
 
-	y = 0;
-	while (y < HEIGHT)
+	ray = generate_camera_ray(scene, x, y);
+	g_stats.primary_rays++;
+	i = y * WIDTH + x;
+	hit = &vars->gbuf.hits[i];
+	vars->gbuf.ids[i] = -1;
+	vars->gbuf.lit[i] = FALSE;
+	vars->gbuf.blended[i] = FALSE;
+	if (trace_primary(scene, ray, hit, &vars->hints))
 	{
-		x = 0;
-		while (x < WIDTH)
-		{
-			ray = generate_camera_ray(scene, x, y);
-			color = trace_ray(scene, ray);
-			put_pixel(vars, x, y, color);
-			x++;
-		}
-		y++;
+		vars->gbuf.colors[i] = shade_hit(scene, hit, &vars->gbuf.lit[i],
+				&vars->hints);
+		vars->gbuf.ids[i] = hit->obj_index;
 	}
+	else
+	{
+		hit->t = -1.0;
+		vars->gbuf.colors[i] = get_sky_color(ray);
+	}
+}
+
+/*
+** Main draw loop for the scene
+** With --subsample, flat regions are interpolated from a sparse lattice;
+** with --aa, edge pixels are then supersampled
+** A BVH rebuilt in the background since the last frame is swapped in
+** first, and the flat list's view list is refreshed for the camera
+*/
+void	main_draw(t_vars *vars, t_scene *scene)
+{
+	long	start;
+
+	accel_poll(scene);
+	accel_view_update(scene);
+	stats_reset();
+	start = time_now_ms();
+	if (vars->opts.subsample)
+		subsample_draw(vars, scene);
+	else
+		trace_all_pixels(vars, scene);
+	if (vars->opts.antialias)
+		antialias_edges(vars, scene);
+	g_stats.frame_ms = time_now_ms() - start;
+	if (vars->opts.stats)
+		stats_print();
+	vars->gbuf.valid = TRUE;
+	vars->gbuf.stale = FALSE;
+	composite_image(vars);
+}
+
+/*
+** Draw the first frame: the --quality-check or --bench-order report if
+** asked for, otherwise a full frame
+*/
+void	draw_first_frame(t_vars *vars, t_scene *scene)
+{
+	if (vars->opts.quality_check)
+		report_subsample_quality(vars, scene);
+	else if (vars->opts.bench_order)
+		report_order_benchmark(vars, scene);
+	else
+		main_draw(vars, scene);
 }
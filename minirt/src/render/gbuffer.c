@@ -0,0 +1,135 @@
+#include "../../includes/minirt_app.h"
+#include "../../includes/gbuffer.h"
+#include "../../includes/accel.h"
+#include "../../includes/stats.h"
+
+/*
+** Allocate the per-pixel G-buffer used for relighting
+*/
+void	gbuffer_init(t_gbuffer *gbuf)
+{
+	gbuf->hits = malloc(sizeof(t_hit) * WIDTH * HEIGHT);
+	gbuf->colors = malloc(sizeof(int) * WIDTH * HEIGHT);
+	gbuf->ids = malloc(sizeof(int) * WIDTH * HEIGHT);
+	gbuf->lit = malloc(sizeof(int) * WIDTH * HEIGHT);
+	gbuf->blended = malloc(sizeof(int) * WIDTH * HEIGHT);
+	gbuf->prev_hits = malloc(sizeof(t_hit) * WIDTH * HEIGHT);
+	gbuf->prev_colors = malloc(sizeof(int) * WIDTH * HEIGHT);
+	gbuf->prev_ids = malloc(sizeof(int) * WIDTH * HEIGHT);
+	gbuf->prev_blended = malloc(sizeof(int) * WIDTH * HEIGHT);
+	if (!gbuf->hits || !gbuf->colors || !gbuf->ids || !gbuf->lit
+		|| !gbuf->blended || !gbuf->prev_hits || !gbuf->prev_colors
+		|| !gbuf->prev_ids || !gbuf->prev_blended)
+		error_exit(ERR_MEMORY);
+	gbuf->valid = FALSE;
+	gbuf->stale = FALSE;
+	gbuf->last_move_ms = 0;
+}
+
+/*
+** Release the G-buffer storage
+*/
+void	gbuffer_free(t_gbuffer *gbuf)
+{
+	free(gbuf->hits);
+	free(gbuf->colors);
+	free(gbuf->ids);
+	free(gbuf->lit);
+	free(gbuf->blended);
+	free(gbuf->prev_hits);
+	free(gbuf->prev_colors);
+	free(gbuf->prev_ids);
+	free(gbuf->prev_blended);
+	gbuf->hits = NULL;
+	gbuf->colors = NULL;
+	gbuf->ids = NULL;
+	gbuf->lit = NULL;
+	gbuf->blended = NULL;
+	gbuf->prev_hits = NULL;
+	gbuf->prev_colors = NULL;
+	gbuf->prev_ids = NULL;
+	gbuf->prev_blended = NULL;
+	gbuf->valid = FALSE;
+}
+
+/*
+** Fetch the current color of an object, so color edits relight correctly
+*/
+static t_color3	object_color(const t_object *obj)
+{
+	if (obj->type == SPHERE)
+		return (obj->data.sphere.material.color);
+	else if (obj->type == PLANE)
+		return (obj->data.plane.material.color);
+	else if (obj->type == CYLINDER)
+		return (obj->data.cylinder.material.color);
+	return (obj->data.cone.material.color);
+}
+
+/*
+** Resolve the pixels --subsample interpolated: their blended hit lies
+** inside curved objects (on the chord between the corners), where it
+** would shadow itself. The pixel's own ray is tested against the object
+** its corners saw, or traced in full if it misses; colors are kept, for
+** the caller to re-shade or carry over
+*/
+void	gbuffer_resolve_blended(t_vars *vars, t_scene *scene)
+{
+	t_hit	hit;
+	t_ray	ray;
+	int		i;
+
+	i = -1;
+	while (++i < WIDTH * HEIGHT)
+	{
+		if (!vars->gbuf.blended[i])
+			continue ;
+		vars->gbuf.blended[i] = FALSE;
+		ray = generate_camera_ray(scene, i % WIDTH, i / WIDTH);
+		g_stats.primary_rays++;
+		hit.t = -1.0;
+		if (trace_object(scene, ray, &hit, vars->gbuf.ids[i]))
+			vars->gbuf.hits[i] = hit;
+		else
+			trace_pixel(vars, scene, i % WIDTH, i / WIDTH);
+	}
+}
+
+/*
+** Re-shade the cached hits after a lighting-only change.
+** Only calculate_lighting (and its shadow rays) runs; primary rays are
+** reused, except for the interpolated pixels, resolved first.
+** The light's caches are refreshed first, since the light may have moved.
+** Re-shading leaves one sample per pixel, so with --aa the sky pixels,
+** which edge samples may have blended, get their one sample back and the
+** edges are supersampled again, as after a full trace.
+** Falls back to a full trace when no frame has been cached yet.
+*/
+void	relight_image(t_vars *vars, t_scene *scene)
+{
+	t_hit	*hit;
+	int		i;
+
+	if (!vars->gbuf.valid)
+		return (main_draw(vars, scene));
+	accel_view_update(scene);
+	gbuffer_resolve_blended(vars, scene);
+	i = 0;
+	while (i < WIDTH * HEIGHT)
+	{
+		hit = &vars->gbuf.hits[i];
+		if (hit->t >= 0)
+		{
+			hit->color = object_color(&scene->objects[hit->obj_index]);
+			vars->gbuf.colors[i] = shade_hit(scene, hit, &vars->gbuf.lit[i],
+					&vars->hints);
+		}
+		else if (vars->opts.antialias)
+			vars->gbuf.colors[i] = get_sky_color(generate_camera_ray(scene,
+						i % WIDTH, i / WIDTH));
+		i++;
+	}
+	if (vars->opts.antialias)
+		antialias_edges(vars, scene);
+	composite_image(vars);
+}
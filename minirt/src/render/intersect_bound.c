@@ -0,0 +1,98 @@
+#include "../includes/minirt_app.h"
+#include "../includes/stats.h"
+
+/*
+** Cylinder: sphere around its mid-axis point reaching the cap rims
+*/
+static t_bound_sphere	cylinder_bound(const t_cylinder *cyl)
+{
+	t_bound_sphere	bound;
+	double			radius;
+
+	bound.center = vec3_add(cyl->center, vec3_mult(cyl->axis,
+				cyl->height / 2.0));
+	radius = sqrt(cyl->height * cyl->height / 4.0
+			+ cyl->diameter * cyl->diameter / 4.0) + EPSILON;
+	bound.radius_sq = radius * radius;
+	return (bound);
+}
+
+/*
+** Cone: smallest sphere through the apex and the base rim, or the
+** sphere around the base disk once that already holds the apex
+*/
+static t_bound_sphere	cone_bound(const t_cone *cone)
+{
+	t_bound_sphere	bound;
+	double			base_radius;
+	double			d;
+
+	base_radius = cone->height * tan(cone->angle / 2.0);
+	if (base_radius >= cone->height)
+		d = cone->height;
+	else
+		d = (cone->height * cone->height + base_radius * base_radius)
+			/ (2.0 * cone->height);
+	bound.center = vec3_add(cone->vertex, vec3_mult(cone->axis, d));
+	if (base_radius >= cone->height)
+		d = base_radius;
+	bound.radius_sq = (d + EPSILON) * (d + EPSILON);
+	return (bound);
+}
+
+/*
+** Refresh the cached bounding sphere of a cylinder or cone; called when
+** the object is added to the scene and after every edit
+*/
+void	object_update_bound(t_object *obj)
+{
+	if (obj->type == CYLINDER)
+		obj->data.cylinder.bound = cylinder_bound(&obj->data.cylinder);
+	else if (obj->type == CONE)
+		obj->data.cone.bound = cone_bound(&obj->data.cone);
+}
+
+/*
+** Origin terms of a cylinder's or cone's bounding sphere
+*/
+void	object_bound_terms(const t_object *obj, t_point3 origin,
+		t_origin_terms *terms)
+{
+	const t_bound_sphere	*bound;
+
+	if (obj->type == CYLINDER)
+		bound = &obj->data.cylinder.bound;
+	else if (obj->type == CONE)
+		bound = &obj->data.cone.bound;
+	else
+		return ;
+	terms->bound_oc = vec3_sub(bound->center, origin);
+	terms->bound_c = vec3_dot(terms->bound_oc, terms->bound_oc)
+		- bound->radius_sq;
+}
+
+/*
+** Cheap test of a unit-direction ray against a bounding sphere it starts
+** outside of: the ray misses the sphere, points away from it, or only
+** enters it past the end of its interval (b - sqrt(disc) > tmax, kept
+** free of the square root)
+** Returns 1 if the object cannot be hit, 0 if the full kernel must run
+*/
+int	bound_rejects(const t_origin_terms *terms, t_ray ray)
+{
+	double	b;
+	double	disc;
+	double	past_tmax;
+
+	g_stats.bound_tests++;
+	if (terms->bound_c <= 0.0)
+		return (0);
+	b = vec3_dot(terms->bound_oc, ray.direction);
+	disc = b * b - terms->bound_c;
+	past_tmax = b - ray.tmax;
+	if (b > 0.0 && disc >= 0.0
+		&& (past_tmax <= 0.0 || past_tmax * past_tmax <= disc))
+		return (0);
+	g_stats.bound_rejects++;
+	return (1);
+}
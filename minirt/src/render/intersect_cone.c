@@ -9,7 +9,6 @@ typedef struct s_cone_constants
 {
 	double	cos_angle;
 	double	sin_angle;
-	double	cos_angle_sq;
 	double	tan_half_angle;
 }	t_cone_constants;
 
@@ -24,30 +23,27 @@ static t_cone_constants	get_cone_constants(const t_cone *cone)
 	half_angle = cone->angle / 2.0;
 	constants.cos_angle = cos(half_angle);
 	constants.sin_angle = sin(half_angle);
-	constants.cos_angle_sq = constants.cos_angle * constants.cos_angle;
 	constants.tan_half_angle = tan(half_angle);
 	return (constants);
 }
 
 /*
-** Compute the quadratic coefficients for a ray-cone intersection.
+** Compute the quadratic coefficients for a ray-cone intersection; the
+** origin terms bring oc, dot(oc, axis), the squared half-angle cosine
+** and c, so no trigonometry is needed here
 ** Returns a t_quadratic struct with the coefficients a, b, c.
 */
-t_quadratic	cone_quadratic_coeffs(const t_cone *cone, t_ray ray)
+t_quadratic	cone_quadratic_coeffs(const t_cone *cone,
+		const t_origin_terms *terms, t_ray ray)
 {
-	t_vec3				oc;
-	double				dv;
-	double				ocv;
-	t_quadratic			q;
-	t_cone_constants	constants;
+	double		dv;
+	t_quadratic	q;
 
-	oc = vec3_sub(ray.origin, cone->vertex);
-	constants = get_cone_constants(cone);
 	dv = vec3_dot(ray.direction, cone->axis);
-	ocv = vec3_dot(oc, cone->axis);
-	q.a = dv * dv - constants.cos_angle_sq;
-	q.b = 2.0 * (dv * ocv - vec3_dot(ray.direction, oc) * constants.cos_angle_sq);
-	q.c = ocv * ocv - vec3_dot(oc, oc) * constants.cos_angle_sq;
+	q.a = dv * dv - terms->cos_sq;
+	q.b = 2.0 * (dv * terms->oc_dot_axis
+			- vec3_dot(ray.direction, terms->oc) * terms->cos_sq);
+	q.c = terms->c;
 	return (q);
 }
 
@@ -73,7 +69,8 @@ t_vec3	cone_surface_normal(const t_cone *cone, t_point3 point)
 ** Calculate intersection with cone base cap (circular base)
 ** Returns 1 if hit, 0 if no hit
 */
-int	intersect_cone_cap(const t_cone *cone, t_ray ray, t_hit *hit)
+int	intersect_cone_cap(const t_cone *cone, t_ray ray,
+		const t_origin_terms *terms, t_hit *hit)
 {
 	double				denom;
 	double				t;
@@ -86,8 +83,8 @@ int	intersect_cone_cap(const t_cone *cone, t_ray ray, t_hit *hit)
 	if (fabs(denom) < EPSILON)
 		return (0);
 	base_center = vec3_add(cone->vertex, vec3_mult(cone->axis, cone->height));
-	t = vec3_dot(vec3_sub(base_center, ray.origin), cone->axis) / denom;
-	if (t <= MIN_T || (hit->t >= 0 && t >= hit->t))
+	t = terms->cap[0].dist / denom;
+	if (t <= ray.tmin || t >= ray.tmax)
 		return (0);
 	point = vec3_add(ray.origin, vec3_mult(ray.direction, t));
 	constants = get_cone_constants(cone);
@@ -108,25 +105,24 @@ int	intersect_cone_cap(const t_cone *cone, t_ray ray, t_hit *hit)
 /*
 ** Check intersection with cone surface and update hit if valid
 */
-static int	check_cone_surface(const t_cone *cone, t_ray ray, t_hit *hit)
+static int	check_cone_surface(const t_cone *cone, t_ray ray,
+		const t_origin_terms *terms, t_hit *hit)
 {
 	t_quadratic	q;
 	double		t;
 	double		m;
 	t_point3	intersection_point;
 
-	q = cone_quadratic_coeffs(cone, ray);
+	q = cone_quadratic_coeffs(cone, terms, ray);
 	if (fabs(q.a) < EPSILON)
 		return (0);
-	t = solve_quadratic(q.a, q.b, q.c, MIN_T);
-	if (t <= MIN_T)
+	t = solve_quadratic(q, ray.tmin, ray.tmax);
+	if (t < 0.0)
 		return (0);
 	intersection_point = vec3_add(ray.origin, vec3_mult(ray.direction, t));
 	m = vec3_dot(vec3_sub(intersection_point, cone->vertex), cone->axis);
 	if (m < 0 || m > cone->height)
 		return (0);
-	if (hit->t >= 0 && t >= hit->t)
-		return (0);
 	hit->t = t;
 	hit->point = intersection_point;
 	hit->normal = cone_surface_normal(cone, hit->point);
@@ -138,16 +134,21 @@ static int	check_cone_surface(const t_cone *cone, t_ray ray, t_hit *hit)
 
 /*
 ** Calculate intersection with cone
+** A surface hit closes the ray's interval before the base cap is tested
 ** Returns 1 if hit, 0 if no hit
 */
-int	intersect_cone(const t_cone *cone, t_ray ray, t_hit *hit)
+int	intersect_cone(const t_cone *cone, t_ray ray,
+		const t_origin_terms *terms, t_hit *hit)
 {
 	int	hit_found;
 
 	hit_found = 0;
-	if (check_cone_surface(cone, ray, hit))
+	if (check_cone_surface(cone, ray, terms, hit))
+	{
 		hit_found = 1;
-	if (intersect_cone_cap(cone, ray, hit))
+		ray.tmax = hit->t;
+	}
+	if (intersect_cone_cap(cone, ray, terms, hit))
 		hit_found = 1;
 	return (hit_found);
 }
@@ -2,43 +2,6 @@
 #include "../includes/scene_math.h"
 #include <math.h>
 
-/*
-** Compute the quadratic coefficients for a ray-cylinder intersection.
-** Returns a t_quadratic struct with the coefficients a, b, c.
-*/
-t_quadratic	cylinder_quadratic_coeffs(const t_cylinder *cylinder, t_ray ray)
-{
-	t_vec3		oc;
-	t_vec3		ray_axis_cross;
-	t_vec3		oc_axis_cross;
-	double		radius;
-	t_quadratic	q;
-
-	oc = vec3_sub(ray.origin, cylinder->center);
-	radius = cylinder->diameter / 2.0;
-	ray_axis_cross = vec3_cross(ray.direction, cylinder->axis);
-	oc_axis_cross = vec3_cross(oc, cylinder->axis);
-	q.a = vec3_dot(ray_axis_cross, ray_axis_cross);
-	q.b = 2.0 * vec3_dot(ray_axis_cross, oc_axis_cross);
-	q.c = vec3_dot(oc_axis_cross, oc_axis_cross) - radius * radius;
-	return (q);
-}
-
-/*
-** Calculate the surface normal for a point on the cylinder.
-*/
-t_vec3	cylinder_surface_normal(const t_cylinder *cylinder, t_point3 point)
-{
-	double		m;
-	t_vec3		axis_projection;
-	t_point3	axis_point;
-
-	m = vec3_dot(vec3_sub(point, cylinder->center), cylinder->axis);
-	axis_projection = vec3_mult(cylinder->axis, m);
-	axis_point = vec3_add(cylinder->center, axis_projection);
-	return (vec3_normalize(vec3_sub(point, axis_point)));
-}
-
 /*
 ** Set hit data for cylinder cap
 */
@@ -63,7 +26,7 @@ static void	set_cap_hit_data(t_hit *hit, const t_cylinder *cyl, int is_top_cap)
 ** Returns 1 if hit, 0 if no hit
 */
 static int	check_cap_hit(const t_cylinder *cyl, t_ray ray, t_hit *hit,
-		double height)
+		const t_cap_terms *cap)
 {
 	double		denom;
 	double		t;
@@ -74,9 +37,9 @@ static int	check_cap_hit(const t_cylinder *cyl, t_ray ray, t_hit *hit,
 	denom = vec3_dot(cyl->axis, ray.direction);
 	if (fabs(denom) < 0.0001)
 		return (0);
-	cap_center = vec3_add(cyl->center, vec3_mult(cyl->axis, height));
-	t = vec3_dot(vec3_sub(cap_center, ray.origin), cyl->axis) / denom;
-	if (t <= 0.001 || (hit->t >= 0 && t >= hit->t))
+	cap_center = vec3_add(cyl->center, vec3_mult(cyl->axis, cap->height));
+	t = cap->dist / denom;
+	if (t <= ray.tmin || t >= ray.tmax)
 		return (0);
 	point = vec3_add(ray.origin, vec3_mult(ray.direction, t));
 	radial = vec3_sub(point, cap_center);
@@ -86,29 +49,27 @@ static int	check_cap_hit(const t_cylinder *cyl, t_ray ray, t_hit *hit,
 		return (0);
 	hit->t = t;
 	hit->point = point;
-	set_cap_hit_data(hit, cyl, (height > 0));
+	set_cap_hit_data(hit, cyl, (cap->height > 0));
 	return (1);
 }
 
 /*
-** Calculate intersection with cylinder
+** Check intersection with the curved side of the cylinder
 ** Returns 1 if hit, 0 if no hit
 */
-int	intersect_cylinder(const t_cylinder *cylinder, t_ray ray, t_hit *hit)
+static int	check_side_hit(const t_cylinder *cylinder, t_ray ray,
+		const t_origin_terms *terms, t_hit *hit)
 {
 	t_quadratic	q;
 	double		t;
 	double		m;
 	t_point3	point;
 
-	if (check_cap_hit(cylinder, ray, hit, 0) || check_cap_hit(cylinder, ray,
-			hit, cylinder->height))
-		return (1);
-	q = cylinder_quadratic_coeffs(cylinder, ray);
+	q = cylinder_quadratic_coeffs(cylinder, terms, ray);
 	if (fabs(q.a) < 0.0001)
 		return (0);
-	t = solve_quadratic(q.a, q.b, q.c, 0.001);
-	if (t <= 0.001 || (hit->t >= 0 && t >= hit->t))
+	t = solve_quadratic(q, ray.tmin, ray.tmax);
+	if (t < 0.0)
 		return (0);
 	point = vec3_add(ray.origin, vec3_mult(ray.direction, t));
 	m = vec3_dot(vec3_sub(point, cylinder->center), cylinder->axis);
@@ -122,3 +83,27 @@ int	intersect_cylinder(const t_cylinder *cylinder, t_ray ray, t_hit *hit)
 	hit->hit_side = 2;
 	return (1);
 }
+
+/*
+** Calculate intersection with cylinder
+** Caps and side are all tested, each one closing the ray's interval at
+** its hit so the nearest one wins
+** Returns 1 if hit, 0 if no hit
+*/
+int	intersect_cylinder(const t_cylinder *cylinder, t_ray ray,
+		const t_origin_terms *terms, t_hit *hit)
+{
+	int	hit_found;
+
+	hit_found = check_cap_hit(cylinder, ray, hit, &terms->cap[0]);
+	if (hit_found)
+		ray.tmax = hit->t;
+	if (check_cap_hit(cylinder, ray, hit, &terms->cap[1]))
+	{
+		hit_found = 1;
+		ray.tmax = hit->t;
+	}
+	if (check_side_hit(cylinder, ray, terms, hit))
+		hit_found = 1;
+	return (hit_found);
+}
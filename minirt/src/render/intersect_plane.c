@@ -17,18 +17,13 @@ int	intersect_plane(const t_plane *plane, t_ray ray, t_hit *hit)
 		return (0);
 	oc = vec3_sub(plane->point, ray.origin);
 	t = vec3_dot(oc, plane->normal) / denom;
-	if (t > 0.001)
-	{
-		if (hit->t < 0 || t < hit->t)
-		{
-			hit->t = t;
-			hit->point = vec3_add(ray.origin, vec3_mult(ray.direction, t));
-			hit->normal = plane->normal;
-			hit->color = plane->material.color;
-			hit->obj_type = PLANE;
-			hit->hit_side = -1;
-			return (1);
-		}
-	}
-	return (0);
+	if (t <= ray.tmin || t >= ray.tmax)
+		return (0);
+	hit->t = t;
+	hit->point = vec3_add(ray.origin, vec3_mult(ray.direction, t));
+	hit->normal = plane->normal;
+	hit->color = plane->material.color;
+	hit->obj_type = PLANE;
+	hit->hit_side = -1;
+	return (1);
 }
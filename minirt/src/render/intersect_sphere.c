@@ -3,20 +3,17 @@
 #include <math.h>
 
 /*
-** Compute quadratic coefficients for ray-sphere intersection
+** Compute quadratic coefficients for ray-sphere intersection; c depends
+** only on the ray origin and comes with its origin terms
 ** Returns coefficients in t_quadratic struct
 */
-t_quadratic	sphere_quadratic_coeffs(const t_sphere *sphere, t_ray ray)
+t_quadratic	sphere_quadratic_coeffs(const t_origin_terms *terms, t_ray ray)
 {
 	t_quadratic	coeffs;
-	t_vec3		oc;
-	double		radius;
 
-	oc = vec3_sub(ray.origin, sphere->center);
-	radius = sphere->diameter / 2.0;
 	coeffs.a = vec3_dot(ray.direction, ray.direction);
-	coeffs.b = 2.0 * vec3_dot(oc, ray.direction);
-	coeffs.c = vec3_dot(oc, oc) - radius * radius;
+	coeffs.b = 2.0 * vec3_dot(terms->oc, ray.direction);
+	coeffs.c = terms->c;
 	return (coeffs);
 }
 
@@ -25,19 +22,18 @@ t_quadratic	sphere_quadratic_coeffs(const t_sphere *sphere, t_ray ray)
 ** Returns 1 if hit, 0 if no hit
 ** Unified implementation - no redundant calculations
 */
-int	intersect_sphere(const t_sphere *sphere, t_ray ray, t_hit *hit)
+int	intersect_sphere(const t_sphere *sphere, t_ray ray,
+		const t_origin_terms *terms, t_hit *hit)
 {
 	t_quadratic	coeffs;
 	double		t;
 
-	coeffs = sphere_quadratic_coeffs(sphere, ray);
+	coeffs = sphere_quadratic_coeffs(terms, ray);
 	if (coeffs.b * coeffs.b < 4.0 * coeffs.a * coeffs.c)
 		return (0);
-	t = solve_quadratic(coeffs.a, coeffs.b, coeffs.c, 0.001);
+	t = solve_quadratic(coeffs, ray.tmin, ray.tmax);
 	if (t < 0.0)
 		return (0);
-	if (hit->t > 0.0 && t >= hit->t)
-		return (0);
 	hit->t = t;
 	hit->point = vec3_add(ray.origin, vec3_mult(ray.direction, t));
 	hit->normal = vec3_normalize(vec3_sub(hit->point, sphere->center));
@@ -1,53 +1,96 @@
 #include "../includes/minirt_app.h"
 #include "../includes/scene_math.h"
+#include "../includes/accel.h"
 
 /*
-** Check intersection with any object type
-** Returns 1 if hit, 0 if no hit
+** Farthest distance still worth testing: the end of the ray's interval,
+** or the closest hit so far if that is nearer
 */
-static int	trace_object(const t_object *obj, t_ray ray, t_hit *closest_hit,
-		int index)
+double	hit_tmax(const t_hit *hit, double tmax)
 {
-	int	hit;
-
-	hit = 0;
-	if (obj->type == SPHERE)
-		hit = intersect_sphere(&obj->data.sphere, ray, closest_hit);
-	else if (obj->type == PLANE)
-		hit = intersect_plane(&obj->data.plane, ray, closest_hit);
-	else if (obj->type == CYLINDER)
-		hit = intersect_cylinder(&obj->data.cylinder, ray, closest_hit);
-	else if (obj->type == CONE)
-		hit = intersect_cone(&obj->data.cone, ray, closest_hit);
-	if (hit)
-		closest_hit->obj_index = index;
-	return (hit);
+	if (hit->t >= 0 && hit->t < tmax)
+		return (hit->t);
+	return (tmax);
 }
 
 /*
-** Check intersection with all objects in scene
+** Check intersection with the bounded objects, skipping any whose box
+** starts beyond the closest hit so far (seeded by the plane pass)
 ** Returns 1 if any hit, 0 if no hit
-** Optimized with early ray termination
 */
-int	trace_objects(const t_scene *scene, t_ray ray, t_hit *closest_hit)
+int	trace_bounded(const t_scene *scene, t_ray ray, t_hit *closest_hit)
+{
+	t_vec3	inv_dir;
+	int		hit_found;
+	int		i;
+
+	inv_dir = ray_inverse_direction(ray);
+	hit_found = 0;
+	i = 0;
+	while (i < scene->accel->num_bounded)
+	{
+		if (aabb_hit(&scene->accel->bounds[scene->accel->bounded[i]], &ray,
+				inv_dir, hit_tmax(closest_hit, ray.tmax))
+			&& trace_object(scene, ray, closest_hit, scene->accel->bounded[i]))
+			hit_found = 1;
+		i++;
+	}
+	return (hit_found);
+}
+
+/*
+** Check intersection through the acceleration data
+** Planes go first, so their nearest hit culls the bounded objects early;
+** those are then searched through the BVH (built up front or lazily),
+** the wide BVH, the grid or a flat list
+** Returns 1 if any hit, 0 if no hit
+*/
+static int	trace_accel(const t_scene *scene, t_ray ray, t_hit *closest_hit)
+{
+	int	hit_found;
+
+	hit_found = trace_planes(scene, ray, closest_hit);
+	if (scene->accel->mode == ACCEL_BVH || scene->accel->mode == ACCEL_LAZY)
+		hit_found |= bvh_trace(scene, ray, closest_hit);
+	else if (scene->accel->mode == ACCEL_WBVH)
+		hit_found |= wbvh_trace(scene, ray, closest_hit);
+	else if (scene->accel->mode == ACCEL_GRID)
+		hit_found |= grid_trace(scene, ray, closest_hit);
+	else
+		hit_found |= trace_bounded(scene, ray, closest_hit);
+	return (hit_found);
+}
+
+/*
+** Like trace_objects, keeping the hit closest_hit already holds (a hint's,
+** say): the ray's interval is closed at it, so only nearer hits replace it
+** Returns 1 if a nearer hit was found, 0 otherwise
+*/
+int	trace_seeded(const t_scene *scene, t_ray ray, t_hit *closest_hit)
 {
 	int		i;
 	int		hit_found;
-	double	min_distance;
 
-	closest_hit->t = -1.0;
+	ray.tmax = hit_tmax(closest_hit, ray.tmax);
+	if (scene->accel)
+		return (trace_accel(scene, ray, closest_hit));
 	hit_found = 0;
-	min_distance = 0.002;
-	if (scene->num_objects == 0)
-		return (0);
 	i = 0;
 	while (i < scene->num_objects)
 	{
-		if (hit_found && closest_hit->t < min_distance)
-			break;
-		if (trace_object(&scene->objects[i], ray, closest_hit, i))
+		if (trace_object(scene, ray, closest_hit, i))
 			hit_found = 1;
 		i++;
 	}
 	return (hit_found);
 }
+
+/*
+** Check intersection with all objects in scene
+** Returns 1 if any hit, 0 if no hit
+*/
+int	trace_objects(const t_scene *scene, t_ray ray, t_hit *closest_hit)
+{
+	closest_hit->t = -1.0;
+	return (trace_seeded(scene, ray, closest_hit));
+}
@@ -1,13 +1,16 @@
 #include "../includes/minirt_app.h"
 #include "../includes/constants.h"
+#include "../includes/stats.h"
+#include "../includes/accel.h"
 #include <math.h>
 
 /*
 ** Calculate diffuse lighting component with attenuation
 ** Formula: light_intensity × light_color × object_color × max(0, dot(normal, light_dir)) × attenuation
 ** where attenuation = 1.0 / (1.0 + ATTENUATION_LINEAR * distance + ATTENUATION_QUADRATIC * distance²)
+** Unlit hits (facing away or in shadow) get no diffuse term.
 */
-t_color3	calculate_diffuse(const t_scene *scene, const t_hit *hit)
+t_color3	calculate_diffuse(const t_scene *scene, const t_hit *hit, int lit)
 {
 	t_vec3		light_dir;
 	double		dot_product;
@@ -15,14 +18,14 @@ t_color3	calculate_diffuse(const t_scene *scene, const t_hit *hit)
 	double		attenuation;
 	t_color3	diffuse;
 
+	if (!lit)
+		return (vec3_create(0.0, 0.0, 0.0));
 	light_dir = vec3_sub(scene->light.position, hit->point);
 	distance = vec3_length(light_dir);
 	light_dir = vec3_normalize(light_dir);
 	dot_product = vec3_dot(hit->normal, light_dir);
 	if (dot_product < 0.0)
 		dot_product = 0.0;
-	if (is_in_shadow(scene, hit->point, scene->light.position))
-		return (vec3_create(0.0, 0.0, 0.0));
 	attenuation = 1.0 / (1.0 + ATTENUATION_LINEAR * distance + ATTENUATION_QUADRATIC * distance * distance);
 	diffuse.x = scene->light.brightness * scene->light.color.x * hit->color.x * dot_product * attenuation;
 	diffuse.y = scene->light.brightness * scene->light.color.y * hit->color.y * dot_product * attenuation;
@@ -31,29 +34,61 @@ t_color3	calculate_diffuse(const t_scene *scene, const t_hit *hit)
 }
 
 /*
-** Check if a point is in shadow from a light source
-** Returns 1 if in shadow, 0 if illuminated
-** Also handles shadow ray setup internally
+** Check whether the light reaches a hit: facing the light and unoccluded
+** Back-facing hits get no diffuse term, so they skip the shadow ray, as
+** do hits whose cell's shadow state is in the light cache; with
+** --shadows map the shadow map is looked up instead
+** hints are the caller's, for its shadow rays (may be NULL)
 */
-int	is_in_shadow(const t_scene *scene, const t_vec3 point,
-		const t_vec3 light_pos)
+int	is_lit(const t_scene *scene, const t_hit *hit, t_hints *hints)
 {
-	t_ray	shadow_ray;
-	t_hit	shadow_hit;
 	t_vec3	light_dir;
-	double	light_distance;
+	int		lit;
 
-	light_dir = vec3_sub(light_pos, point);
-	light_distance = vec3_length(light_dir);
-	light_dir = vec3_normalize(light_dir);
-	shadow_ray.origin = vec3_add(point, vec3_mult(light_dir, SHADOW_EPSILON));
-	shadow_ray.direction = light_dir;
-	if (trace_objects(scene, shadow_ray, &shadow_hit))
-	{
-		if (shadow_hit.t < light_distance - SHADOW_EPSILON)
-			return (1);
-	}
-	return (0);
+	light_dir = vec3_sub(scene->light.position, hit->point);
+	if (vec3_dot(hit->normal, light_dir) <= 0.0)
+		return (0);
+	if (scene->accel && scene->accel->shadow_map.depth)
+		return (shadow_map_lit(scene, hit));
+	lit = light_cache_lookup(scene, hit);
+	if (lit >= 0)
+		return (lit);
+	lit = !is_in_shadow(scene, hit->point, hit->obj_index, hints);
+	light_cache_store(scene, hit, lit);
+	return (lit);
+}
+
+/*
+** Shadow ray for a point: cast from the light towards the point, with
+** its interval ending just short of it, so every shadow ray of a frame
+** shares the light's cached origin terms
+*/
+t_ray	shadow_ray(const t_vec3 point, const t_vec3 light_pos)
+{
+	t_ray	ray;
+	t_vec3	to_point;
+	double	distance;
+
+	to_point = vec3_sub(point, light_pos);
+	distance = vec3_length(to_point);
+	ray.origin = light_pos;
+	ray.direction = vec3_normalize(to_point);
+	ray.tmin = MIN_T;
+	ray.tmax = distance - MIN_T;
+	return (ray);
+}
+
+/*
+** Check if a point is in shadow from the scene's light
+** Returns 1 if in shadow, 0 if illuminated
+** receiver is the object the point lies on, whose caster list is tested
+*/
+int	is_in_shadow(const t_scene *scene, const t_vec3 point, int receiver,
+		t_hints *hints)
+{
+	g_stats.shadow_rays++;
+	return (trace_shadow(scene, shadow_ray(point, scene->light.position),
+			receiver, hints));
 }
 
 /*
@@ -62,8 +97,9 @@ int	is_in_shadow(const t_scene *scene, const t_vec3 point,
 ** Formula: ambient + diffuse, where:
 ** - ambient = ambient_ratio × ambient_color × object_color
 ** - diffuse = light_intensity × light_color × object_color × max(0, dot(normal, light_dir)) × attenuation
+** lit is the shadow state from is_lit, so callers can record or reuse it
 */
-t_color3	calculate_lighting(const t_scene *scene, const t_hit *hit)
+t_color3	calculate_lighting(const t_scene *scene, const t_hit *hit, int lit)
 {
 	t_color3	final_color;
 	t_color3	ambient;
@@ -73,7 +109,7 @@ t_color3	calculate_lighting(const t_scene *scene, const t_hit *hit)
 	ambient.z = scene->ambient.ratio * scene->ambient.color.z * hit->color.z;
 
 
-	final_color = vec3_add(ambient, calculate_diffuse(scene, hit));
+	final_color = vec3_add(ambient, calculate_diffuse(scene, hit, lit));
 	final_color = clamp_color(final_color);
 	return (final_color);
 }
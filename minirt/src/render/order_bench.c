@@ -0,0 +1,72 @@
+#include "../../includes/minirt_app.h"
+#include "../../includes/accel.h"
+#include "../../includes/stats.h"
+#include <stdio.h>
+
+/*
+** Print an order's time with the counters the order moves: how often a
+** hinted primary ray hits its predecessor's object, out of the rays
+** hinted (none when every ray before hit a plane or nothing, as planes
+** are not hinted), and the casters the shadow pass keeps per wave
+*/
+static void	print_order(int order, long best)
+{
+	static const char	*names[ORDERS] = {"scanline", "tiled", "morton",
+		"hilbert"};
+
+	printf("  %-8s %8.1f ms, primary hints %.1f%% of %ld, %.1f casters "
+		"per wave\n", names[order], best / 1e3, 100.0
+		* g_stats.primary_hint_hits / fmax(1.0, g_stats.primary_hints),
+		g_stats.primary_hints, g_stats.tile_casters
+		/ fmax(1.0, g_stats.shadow_tiles));
+}
+
+/*
+** Time full frames traced in one pixel order, keeping the fastest of
+** BENCH_ORDER_RUNS, and print it
+*/
+static void	bench_order(t_vars *vars, t_scene *scene, int order)
+{
+	long	best;
+	long	start;
+	long	elapsed;
+	int		run;
+
+	vars->opts.order = order;
+	best = LONG_MAX;
+	run = -1;
+	while (++run < BENCH_ORDER_RUNS)
+	{
+		stats_reset();
+		start = time_now_us();
+		trace_all_pixels(vars, scene);
+		elapsed = time_now_us() - start;
+		if (elapsed < best)
+			best = elapsed;
+	}
+	print_order(order, best);
+}
+
+/*
+** Benchmark for --bench-order: trace the first frame in the scanline,
+** tiled, Morton and Hilbert orders after one warm-up frame (which also
+** builds what the structures build lazily) and report each one's time.
+** The orders give the same image, which is left in the G-buffer.
+*/
+void	report_order_benchmark(t_vars *vars, t_scene *scene)
+{
+	int	user_order;
+	int	order;
+
+	user_order = vars->opts.order;
+	accel_poll(scene);
+	accel_view_update(scene);
+	trace_all_pixels(vars, scene);
+	printf("Pixel order benchmark (best of %d frames):\n", BENCH_ORDER_RUNS);
+	order = -1;
+	while (++order < ORDERS)
+		bench_order(vars, scene, order);
+	vars->opts.order = user_order;
+	vars->gbuf.valid = TRUE;
+	composite_image(vars);
+}
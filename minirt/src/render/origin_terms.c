@@ -0,0 +1,74 @@
+#include "../includes/minirt_app.h"
+
+/*
+** Sphere: oc and the constant term |oc|^2 - r^2
+*/
+static void	sphere_terms(const t_sphere *sphere, t_point3 origin,
+		t_origin_terms *terms)
+{
+	double	radius;
+
+	terms->oc = vec3_sub(origin, sphere->center);
+	radius = sphere->diameter / 2.0;
+	terms->c = vec3_dot(terms->oc, terms->oc) - radius * radius;
+}
+
+/*
+** Cylinder: cross(oc, axis), the constant term |cross(oc, axis)|^2 - r^2
+** and the distances to the bottom and top cap planes
+*/
+static void	cylinder_terms(const t_cylinder *cyl, t_point3 origin,
+		t_origin_terms *terms)
+{
+	double	radius;
+	int		i;
+
+	terms->oc = vec3_sub(origin, cyl->center);
+	radius = cyl->diameter / 2.0;
+	terms->oc_axis = vec3_cross(terms->oc, cyl->axis);
+	terms->c = vec3_dot(terms->oc_axis, terms->oc_axis) - radius * radius;
+	terms->cap[0].height = 0;
+	terms->cap[1].height = cyl->height;
+	i = -1;
+	while (++i < 2)
+		terms->cap[i].dist = vec3_dot(vec3_sub(vec3_add(cyl->center,
+						vec3_mult(cyl->axis, terms->cap[i].height)), origin),
+				cyl->axis);
+}
+
+/*
+** Cone: oc from the apex, dot(oc, axis), the squared half-angle cosine,
+** the constant term dot(oc, axis)^2 - |oc|^2 cos^2 and the distance to
+** the base plane
+*/
+static void	cone_terms(const t_cone *cone, t_point3 origin,
+		t_origin_terms *terms)
+{
+	double	cos_angle;
+
+	terms->oc = vec3_sub(origin, cone->vertex);
+	cos_angle = cos(cone->angle / 2.0);
+	terms->cos_sq = cos_angle * cos_angle;
+	terms->oc_dot_axis = vec3_dot(terms->oc, cone->axis);
+	terms->c = terms->oc_dot_axis * terms->oc_dot_axis
+		- vec3_dot(terms->oc, terms->oc) * terms->cos_sq;
+	terms->cap[0].height = cone->height;
+	terms->cap[0].dist = vec3_dot(vec3_sub(vec3_add(cone->vertex,
+					vec3_mult(cone->axis, cone->height)), origin), cone->axis);
+}
+
+/*
+** Fill the terms of an object's test that depend only on the ray origin
+** (all but the bounding sphere's, see object_bound_terms); planes have
+** none
+*/
+void	object_origin_terms(const t_object *obj, t_point3 origin,
+		t_origin_terms *terms)
+{
+	if (obj->type == SPHERE)
+		sphere_terms(&obj->data.sphere, origin, terms);
+	else if (obj->type == CYLINDER)
+		cylinder_terms(&obj->data.cylinder, origin, terms);
+	else if (obj->type == CONE)
+		cone_terms(&obj->data.cone, origin, terms);
+}
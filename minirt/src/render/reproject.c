@@ -0,0 +1,117 @@
+#include "../../includes/minirt_app.h"
+#include "../../includes/gbuffer.h"
+#include "../../includes/accel.h"
+
+/*
+** Swap a per-pixel buffer with its prev_* counterpart
+*/
+static void	swap_buffers(int **current, int **prev)
+{
+	int	*tmp;
+
+	tmp = *prev;
+	*prev = *current;
+	*current = tmp;
+}
+
+/*
+** Move the last frame into the prev_* buffers and clear the current ones
+*/
+static void	start_reprojection(t_gbuffer *gbuf)
+{
+	t_hit	*hits;
+	int		i;
+
+	hits = gbuf->prev_hits;
+	gbuf->prev_hits = gbuf->hits;
+	gbuf->hits = hits;
+	swap_buffers(&gbuf->colors, &gbuf->prev_colors);
+	swap_buffers(&gbuf->ids, &gbuf->prev_ids);
+	swap_buffers(&gbuf->blended, &gbuf->prev_blended);
+	i = 0;
+	while (i < WIDTH * HEIGHT)
+	{
+		gbuf->ids[i] = REPROJ_EMPTY;
+		gbuf->hits[i].t = -1.0;
+		gbuf->blended[i] = FALSE;
+		i++;
+	}
+}
+
+/*
+** Project a world-space point into the new camera (inverse of
+** generate_camera_ray). Returns the pixel index, or -1 if off-screen.
+*/
+static int	project_point(const t_view *view, t_point3 point, double *depth)
+{
+	t_vec3	d;
+	double	z;
+	double	sx;
+	double	sy;
+
+	d = vec3_sub(point, view->origin);
+	z = vec3_dot(d, view->forward);
+	if (z <= EPSILON)
+		return (-1);
+	sx = floor(vec3_dot(d, view->right) / (z * view->pixel_scale)
+			+ WIDTH / 2.0 + 0.5);
+	sy = floor(HEIGHT / 2.0 - vec3_dot(d, view->up)
+			/ (z * view->pixel_scale) + 0.5);
+	if (sx < 0 || sx >= WIDTH || sy < 0 || sy >= HEIGHT)
+		return (-1);
+	*depth = vec3_length(d);
+	return ((int)sy * WIDTH + (int)sx);
+}
+
+/*
+** Scatter the previous frame's hits into the new camera, keeping the
+** nearest sample per pixel. Shading is view-independent, so colors carry
+** over unchanged.
+*/
+static void	scatter_previous(t_gbuffer *gbuf, const t_view *view)
+{
+	double	depth;
+	int		i;
+	int		j;
+
+	i = 0;
+	while (i < WIDTH * HEIGHT)
+	{
+		j = -1;
+		if (gbuf->prev_ids[i] >= 0)
+			j = project_point(view, gbuf->prev_hits[i].point, &depth);
+		if (j >= 0 && (gbuf->ids[j] == REPROJ_EMPTY
+				|| depth < gbuf->hits[j].t))
+		{
+			gbuf->hits[j] = gbuf->prev_hits[i];
+			gbuf->hits[j].t = depth;
+			gbuf->colors[j] = gbuf->prev_colors[i];
+			gbuf->ids[j] = gbuf->prev_ids[i];
+			gbuf->blended[j] = gbuf->prev_blended[i];
+		}
+		i++;
+	}
+}
+
+/*
+** Draw a camera move by reprojecting the previous frame and re-tracing
+** only disoccluded or invalid pixels; interpolated pixels carried over
+** are resolved in the new camera. The image is marked stale so the
+** idle hook refreshes it fully once the camera stops.
+*/
+void	reproject_draw(t_vars *vars, t_scene *scene)
+{
+	t_view	view;
+
+	if (!vars->gbuf.valid)
+		return (main_draw(vars, scene));
+	view = camera_view(scene);
+	accel_view_update(scene);
+	start_reprojection(&vars->gbuf);
+	scatter_previous(&vars->gbuf, &view);
+	retrace_invalid_pixels(vars, scene);
+	gbuffer_resolve_blended(vars, scene);
+	vars->gbuf.stale = TRUE;
+	vars->gbuf.last_move_ms = time_now_ms();
+	composite_image(vars);
+}
@@ -0,0 +1,98 @@
+#include "../../includes/minirt_app.h"
+#include "../../includes/gbuffer.h"
+
+/*
+** Check whether neighbour j disagrees with pixel i on object or depth
+** Holes are not counted here, they are re-traced on their own
+*/
+static int	differs(const t_gbuffer *gbuf, int i, int j)
+{
+	if (gbuf->ids[j] == REPROJ_EMPTY)
+		return (0);
+	if (gbuf->ids[i] != gbuf->ids[j])
+		return (1);
+	return (fabs(gbuf->hits[i].t - gbuf->hits[j].t)
+		> REPROJ_DEPTH_TOLERANCE * gbuf->hits[i].t);
+}
+
+/*
+** A one-pixel crack left by splatting onto a magnified surface, with both
+** opposite neighbours on the same object and depth. Returns the neighbour
+** to copy from, or -1 if the hole is a real disocclusion.
+*/
+static int	crack_source(const t_gbuffer *gbuf, int x, int y)
+{
+	int	i;
+
+	i = y * WIDTH + x;
+	if (x > 0 && x < WIDTH - 1 && gbuf->ids[i - 1] >= 0
+		&& gbuf->ids[i - 1] == gbuf->ids[i + 1]
+		&& !differs(gbuf, i - 1, i + 1))
+		return (i - 1);
+	if (y > 0 && y < HEIGHT - 1 && gbuf->ids[i - WIDTH] >= 0
+		&& gbuf->ids[i - WIDTH] == gbuf->ids[i + WIDTH]
+		&& !differs(gbuf, i - WIDTH, i + WIDTH))
+		return (i - WIDTH);
+	return (-1);
+}
+
+/*
+** A reprojected pixel is invalid if nothing landed on it (disocclusion)
+** or if it sits on an object-ID or depth discontinuity.
+** Returns REPROJ_KEEP, REPROJ_RETRACE or the index of a crack source + 2.
+*/
+static int	needs_retrace(const t_gbuffer *gbuf, int x, int y)
+{
+	int	i;
+	int	src;
+
+	i = y * WIDTH + x;
+	if (gbuf->ids[i] == REPROJ_EMPTY)
+	{
+		src = crack_source(gbuf, x, y);
+		if (src < 0)
+			return (REPROJ_RETRACE);
+		return (src + 2);
+	}
+	return ((x > 0 && differs(gbuf, i, i - 1))
+		|| (x < WIDTH - 1 && differs(gbuf, i, i + 1))
+		|| (y > 0 && differs(gbuf, i, i - WIDTH))
+		|| (y < HEIGHT - 1 && differs(gbuf, i, i + WIDTH)));
+}
+
+/*
+** Fill a crack from its neighbour
+*/
+static void	copy_pixel(t_gbuffer *gbuf, int src, int dst)
+{
+	gbuf->hits[dst] = gbuf->hits[src];
+	gbuf->colors[dst] = gbuf->colors[src];
+	gbuf->ids[dst] = gbuf->ids[src];
+	gbuf->blended[dst] = gbuf->blended[src];
+}
+
+/*
+** Mark invalid pixels first (prev_ids is free after scattering), then
+** trace them, so the tests only see reprojected data
+*/
+void	retrace_invalid_pixels(t_vars *vars, t_scene *scene)
+{
+	int	i;
+
+	i = 0;
+	while (i < WIDTH * HEIGHT)
+	{
+		vars->gbuf.prev_ids[i] = needs_retrace(&vars->gbuf, i % WIDTH,
+				i / WIDTH);
+		i++;
+	}
+	i = 0;
+	while (i < WIDTH * HEIGHT)
+	{
+		if (vars->gbuf.prev_ids[i] == REPROJ_RETRACE)
+			trace_pixel(vars, scene, i % WIDTH, i / WIDTH);
+		else if (vars->gbuf.prev_ids[i] != REPROJ_KEEP)
+			copy_pixel(&vars->gbuf, vars->gbuf.prev_ids[i] - 2, i);
+		i++;
+	}
+}
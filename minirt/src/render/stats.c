@@ -0,0 +1,77 @@
+#include "../../includes/minirt_app.h"
+#include "../../includes/accel.h"
+#include "../../includes/stats.h"
+#include <stdio.h>
+
+t_render_stats	g_stats;
+
+/*
+** Clear the per-frame counters
+*/
+void	stats_reset(void)
+{
+	long	build_ms;
+
+	build_ms = g_stats.build_ms;
+	ft_bzero(&g_stats, sizeof(t_render_stats));
+	g_stats.build_ms = build_ms;
+}
+
+/*
+** Print the shadow counters: tile culls and packets, with how much of a
+** packet's lanes each sphere solve uses, hints and caches
+*/
+static void	print_shadow_stats(void)
+{
+	printf("  Shadow tiles: %ld tiles, %.1f casters per tile, %ld packets\n",
+		g_stats.shadow_tiles, g_stats.tile_casters
+		/ fmax(1.0, g_stats.shadow_tiles), g_stats.shadow_packets);
+	printf("  Packets: %.1f sphere tests per packet, %ld solves, "
+		"%.1f%% of lanes used\n", g_stats.packet_tests
+		/ fmax(1.0, g_stats.shadow_packets), g_stats.packet_solves,
+		100.0 * g_stats.packet_lanes
+		/ fmax(1.0, SHADOW_PACKET * g_stats.packet_solves));
+	printf("  Hints: primary %.1f%% of %ld, occluder %.1f%% of %ld\n",
+		100.0 * g_stats.primary_hint_hits / fmax(1.0, g_stats.primary_hints),
+		g_stats.primary_hints, 100.0 * g_stats.occluder_hint_hits
+		/ fmax(1.0, g_stats.occluder_hints), g_stats.occluder_hints);
+	printf("  Light cache: %.1f%% of %ld lookups hit\n",
+		100.0 * g_stats.light_cache_hits
+		/ fmax(1.0, g_stats.light_cache_lookups),
+		g_stats.light_cache_lookups);
+	printf("  Shadow map: %ld texels traced\n", g_stats.shadow_map_texels);
+}
+
+/*
+** Print the counters of the last full frame
+*/
+void	stats_print(void)
+{
+	printf("Frame: %ld ms, %ld primary rays, %ld shadow rays\n",
+		g_stats.frame_ms, g_stats.primary_rays, g_stats.shadow_rays);
+	printf("  Accel: build %ld ms, trace %ld ms\n",
+		g_stats.build_ms, g_stats.frame_ms);
+	printf("  AA: %.2f%% pixels supersampled, %ld extra samples\n",
+		100.0 * g_stats.aa_pixels / (WIDTH * HEIGHT), g_stats.aa_samples);
+	printf("  Bounds: %ld cylinder/cone tests, %ld rejected early\n",
+		g_stats.bound_tests, g_stats.bound_rejects);
+	print_shadow_stats();
+	printf("  Stages (ms): generate %.1f, intersect %.1f, compact %.1f, "
+		"shadow %.1f, shade %.1f\n", g_stats.stage_us[WAVE_GENERATE] / 1e3,
+		g_stats.stage_us[WAVE_INTERSECT] / 1e3, g_stats.stage_us[WAVE_COMPACT]
+		/ 1e3, g_stats.stage_us[WAVE_SHADOW] / 1e3,
+		g_stats.stage_us[WAVE_SHADE] / 1e3);
+}
+
+/*
+** Add the time since *start to a wavefront stage and restart the clock
+** for the next stage
+*/
+void	stats_stage_end(int stage, long *start)
+{
+	long	now;
+
+	now = time_now_us();
+	g_stats.stage_us[stage] += now - *start;
+	*start = now;
+}
@@ -0,0 +1,115 @@
+#include "../../includes/minirt_app.h"
+#include "../../includes/gbuffer.h"
+
+/*
+** Next lattice coordinate: every SUBSAMPLE_STEP pixels, plus the last one
+*/
+static int	lattice_next(int coord, int size)
+{
+	if (coord + SUBSAMPLE_STEP >= size)
+		return (size - 1);
+	return (coord + SUBSAMPLE_STEP);
+}
+
+/*
+** Trace the sparse lattice, recording object index and shadow state
+*/
+static void	trace_lattice(t_vars *vars, t_scene *scene)
+{
+	int	x;
+	int	y;
+
+	y = 0;
+	while (1)
+	{
+		x = 0;
+		while (1)
+		{
+			trace_pixel(vars, scene, x, y);
+			if (x == WIDTH - 1)
+				break ;
+			x = lattice_next(x, WIDTH);
+		}
+		if (y == HEIGHT - 1)
+			break ;
+		y = lattice_next(y, HEIGHT);
+	}
+}
+
+/*
+** A block is flat when its four lattice corners see the same object
+** (or sky) with the same shadow state
+*/
+static int	block_is_flat(const t_gbuffer *gbuf, const t_block *b)
+{
+	int	c00;
+	int	c10;
+	int	c01;
+	int	c11;
+
+	c00 = b->y0 * WIDTH + b->x0;
+	c10 = b->y0 * WIDTH + b->x1;
+	c01 = b->y1 * WIDTH + b->x0;
+	c11 = b->y1 * WIDTH + b->x1;
+	return (gbuf->ids[c00] == gbuf->ids[c10]
+		&& gbuf->ids[c00] == gbuf->ids[c01]
+		&& gbuf->ids[c00] == gbuf->ids[c11]
+		&& gbuf->lit[c00] == gbuf->lit[c10]
+		&& gbuf->lit[c00] == gbuf->lit[c01]
+		&& gbuf->lit[c00] == gbuf->lit[c11]);
+}
+
+/*
+** Fill the pixels owned by a block: interpolated when flat, traced
+** otherwise. A block owns [x0, x1) x [y0, y1), plus the last column or
+** row of the image; lattice points are already traced.
+*/
+static void	fill_block(t_vars *vars, t_scene *scene, const t_block *b)
+{
+	int	flat;
+	int	x;
+	int	y;
+
+	flat = block_is_flat(&vars->gbuf, b);
+	y = b->y0;
+	while (y < b->y1 || (y == b->y1 && y == HEIGHT - 1))
+	{
+		x = b->x0;
+		while (x < b->x1 || (x == b->x1 && x == WIDTH - 1))
+		{
+			if (!is_lattice_point(x, y))
+			{
+				if (flat)
+					interpolate_pixel(&vars->gbuf, b, x, y);
+				else
+					trace_pixel(vars, scene, x, y);
+			}
+			x++;
+		}
+		y++;
+	}
+}
+
+/*
+** Adaptive subsampling: trace every SUBSAMPLE_STEP-th pixel first, then
+** interpolate blocks whose corners agree and trace the others fully
+*/
+void	subsample_draw(t_vars *vars, t_scene *scene)
+{
+	t_block	b;
+
+	trace_lattice(vars, scene);
+	b.y0 = 0;
+	while (b.y0 < HEIGHT - 1)
+	{
+		b.y1 = lattice_next(b.y0, HEIGHT);
+		b.x0 = 0;
+		while (b.x0 < WIDTH - 1)
+		{
+			b.x1 = lattice_next(b.x0, WIDTH);
+			fill_block(vars, scene, &b);
+			b.x0 = b.x1;
+		}
+		b.y0 = b.y1;
+	}
+}
@@ -0,0 +1,100 @@
+#include "../../includes/minirt_app.h"
+#include "../../includes/gbuffer.h"
+
+/*
+** Check whether a pixel lies on the subsampling lattice
+*/
+int	is_lattice_point(int x, int y)
+{
+	return ((x % SUBSAMPLE_STEP == 0 || x == WIDTH - 1)
+		&& (y % SUBSAMPLE_STEP == 0 || y == HEIGHT - 1));
+}
+
+/*
+** Bilinear blend of one 8-bit channel of the four corner colors
+*/
+static int	blend_channel(const int *c, int shift, double fx, double fy)
+{
+	double	top;
+	double	bottom;
+
+	top = ((c[0] >> shift) & 0xFF) * (1.0 - fx)
+		+ ((c[1] >> shift) & 0xFF) * fx;
+	bottom = ((c[2] >> shift) & 0xFF) * (1.0 - fx)
+		+ ((c[3] >> shift) & 0xFF) * fx;
+	return ((int)(top * (1.0 - fy) + bottom * fy + 0.5) << shift);
+}
+
+/*
+** Bilinear blend of a vector attribute of the four corner hits
+*/
+static t_vec3	blend_vec(const t_vec3 *v, double fx, double fy)
+{
+	t_vec3	top;
+	t_vec3	bottom;
+
+	top = vec3_add(vec3_mult(v[0], 1.0 - fx), vec3_mult(v[1], fx));
+	bottom = vec3_add(vec3_mult(v[2], 1.0 - fx), vec3_mult(v[3], fx));
+	return (vec3_add(vec3_mult(top, 1.0 - fy), vec3_mult(bottom, fy)));
+}
+
+/*
+** Blend the G-buffer hit of an interpolated pixel, so reprojection and
+** the edge tests still have a point, normal and depth; on curved
+** surfaces the point lies inside the object, so the pixel is marked
+** blended and resolved before it is shaded again
+*/
+static void	blend_hit(t_gbuffer *gbuf, const int *corner, int i, double *f)
+{
+	t_vec3	point[4];
+	t_vec3	normal[4];
+	t_vec3	depth[4];
+	int		k;
+
+	gbuf->hits[i] = gbuf->hits[corner[0]];
+	if (gbuf->ids[corner[0]] < 0)
+		return ;
+	k = 0;
+	while (k < 4)
+	{
+		point[k] = gbuf->hits[corner[k]].point;
+		normal[k] = gbuf->hits[corner[k]].normal;
+		depth[k] = vec3_create(gbuf->hits[corner[k]].t, 0, 0);
+		k++;
+	}
+	gbuf->hits[i].point = blend_vec(point, f[0], f[1]);
+	gbuf->hits[i].normal = vec3_normalize(blend_vec(normal, f[0], f[1]));
+	gbuf->hits[i].t = blend_vec(depth, f[0], f[1]).x;
+}
+
+/*
+** Interpolate a pixel inside a flat block from its four lattice corners
+*/
+void	interpolate_pixel(t_gbuffer *gbuf, const t_block *b, int x, int y)
+{
+	int		corner[4];
+	int		colors[4];
+	double	f[2];
+	int		i;
+
+	corner[0] = b->y0 * WIDTH + b->x0;
+	corner[1] = b->y0 * WIDTH + b->x1;
+	corner[2] = b->y1 * WIDTH + b->x0;
+	corner[3] = b->y1 * WIDTH + b->x1;
+	i = 0;
+	while (i < 4)
+	{
+		colors[i] = gbuf->colors[corner[i]];
+		i++;
+	}
+	f[0] = (double)(x - b->x0) / (b->x1 - b->x0);
+	f[1] = (double)(y - b->y0) / (b->y1 - b->y0);
+	i = y * WIDTH + x;
+	gbuf->colors[i] = blend_channel(colors, 16, f[0], f[1])
+		| blend_channel(colors, 8, f[0], f[1])
+		| blend_channel(colors, 0, f[0], f[1]);
+	blend_hit(gbuf, corner, i, f);
+	gbuf->ids[i] = gbuf->ids[corner[0]];
+	gbuf->lit[i] = gbuf->lit[corner[0]];
+	gbuf->blended[i] = (gbuf->ids[i] >= 0);
+}
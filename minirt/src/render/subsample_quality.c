@@ -0,0 +1,104 @@
+#include "../../includes/minirt_app.h"
+#include "../../includes/gbuffer.h"
+#include "../../includes/accel.h"
+#include "../../includes/stats.h"
+#include <stdio.h>
+
+/*
+** Largest per-channel difference between two packed colors
+*/
+static int	channel_error(int a, int b)
+{
+	int	err;
+	int	shift;
+	int	diff;
+
+	err = 0;
+	shift = 0;
+	while (shift <= 16)
+	{
+		diff = abs(((a >> shift) & 0xFF) - ((b >> shift) & 0xFF));
+		if (diff > err)
+			err = diff;
+		shift += 8;
+	}
+	return (err);
+}
+
+/*
+** Peak signal-to-noise ratio of an image, from its summed squared
+** channel errors
+** Returns it in dB, or INFINITY for an exact match
+*/
+static double	psnr(double sum_sq)
+{
+	if (sum_sq == 0.0)
+		return (INFINITY);
+	return (10.0 * log10(255.0 * 255.0 * WIDTH * HEIGHT / sum_sq));
+}
+
+/*
+** Compare the subsampled colors against the full render and print
+** the fraction of differing pixels, the worst error and the PSNR
+** Returns the PSNR
+*/
+static double	print_quality(const int *approx, const int *full)
+{
+	double	sum_sq;
+	int		differing;
+	int		max_err;
+	int		err;
+	int		i;
+
+	sum_sq = 0.0;
+	differing = 0;
+	max_err = 0;
+	i = -1;
+	while (++i < WIDTH * HEIGHT)
+	{
+		err = channel_error(approx[i], full[i]);
+		differing += (err > 0);
+		if (err > max_err)
+			max_err = err;
+		sum_sq += (double)err * err;
+	}
+	printf("Subsample quality: %.3f%% pixels differ, max error %d, "
+		"PSNR %.2f dB\n", 100.0 * differing / (WIDTH * HEIGHT), max_err,
+		psnr(sum_sq));
+	return (psnr(sum_sq));
+}
+
+/*
+** Quality test for --subsample: render the frame both ways, report the
+** timings and the error of the subsampled image against the full one,
+** then exit: with failure if its PSNR is below QUALITY_MIN_PSNR, so that
+** scripts (make test) can run it. The structures are brought up to date
+** for the frame first, as in main_draw.
+*/
+void	report_subsample_quality(t_vars *vars, t_scene *scene)
+{
+	int		*approx;
+	long	start;
+	long	subsample_ms;
+	double	quality;
+
+	approx = malloc(sizeof(int) * WIDTH * HEIGHT);
+	if (!approx)
+		error_exit(ERR_MEMORY);
+	accel_poll(scene);
+	accel_view_update(scene);
+	stats_reset();
+	start = time_now_ms();
+	subsample_draw(vars, scene);
+	subsample_ms = time_now_ms() - start;
+	ft_memcpy(approx, vars->gbuf.colors, sizeof(int) * WIDTH * HEIGHT);
+	start = time_now_ms();
+	trace_all_pixels(vars, scene);
+	printf("Subsampled render: %ld ms, full render: %ld ms\n",
+		subsample_ms, time_now_ms() - start);
+	quality = print_quality(approx, vars->gbuf.colors);
+	free(approx);
+	if (quality < QUALITY_MIN_PSNR)
+		error_exit("Error: subsampled render below QUALITY_MIN_PSNR\n");
+	exit(EXIT_SUCCESS);
+}
@@ -0,0 +1,79 @@
+#include "../includes/minirt_app.h"
+#include "../includes/accel.h"
+
+/*
+** Cached origin terms of an object, if the ray starts where a cache was
+** filled (primary rays start at the camera, shadow rays at the light)
+*/
+static const t_origin_terms	*cached_terms(const t_scene *scene,
+		t_point3 origin, int index)
+{
+	if (!scene->accel)
+		return (NULL);
+	if (origin_cache_matches(&scene->accel->camera, origin))
+		return (&scene->accel->camera.terms[index]);
+	if (origin_cache_matches(&scene->accel->light, origin))
+		return (&scene->accel->light.terms[index]);
+	return (NULL);
+}
+
+/*
+** Origin terms for testing the ray against an object: from the cache, or
+** computed into local, the bounding sphere's first so that rays it
+** rejects never pay for the rest
+** Returns NULL if the bounding sphere rejects the ray
+*/
+static const t_origin_terms	*object_terms(const t_scene *scene, t_ray ray,
+		int index, t_origin_terms *local)
+{
+	const t_object			*obj;
+	const t_origin_terms	*terms;
+
+	obj = &scene->objects[index];
+	terms = cached_terms(scene, ray.origin, index);
+	if (!terms)
+	{
+		object_bound_terms(obj, ray.origin, local);
+		terms = local;
+	}
+	if ((obj->type == CYLINDER || obj->type == CONE)
+		&& bound_rejects(terms, ray))
+		return (NULL);
+	if (terms == local)
+		object_origin_terms(obj, ray.origin, local);
+	return (terms);
+}
+
+/*
+** Check intersection with any object type, with the ray's interval
+** closed at the closest hit so far; the kernels only evaluate the terms
+** that depend on the ray direction
+** Returns 1 if hit, 0 if no hit
+*/
+int	trace_object(const t_scene *scene, t_ray ray, t_hit *closest_hit,
+		int index)
+{
+	const t_object			*obj;
+	const t_origin_terms	*terms;
+	t_origin_terms			local;
+	int						hit;
+
+	ray.tmax = hit_tmax(closest_hit, ray.tmax);
+	obj = &scene->objects[index];
+	terms = object_terms(scene, ray, index, &local);
+	hit = 0;
+	if (!terms)
+		return (0);
+	if (obj->type == SPHERE)
+		hit = intersect_sphere(&obj->data.sphere, ray, terms, closest_hit);
+	else if (obj->type == PLANE)
+		hit = intersect_plane(&obj->data.plane, ray, closest_hit);
+	else if (obj->type == CYLINDER)
+		hit = intersect_cylinder(&obj->data.cylinder, ray, terms,
+				closest_hit);
+	else if (obj->type == CONE)
+		hit = intersect_cone(&obj->data.cone, ray, terms, closest_hit);
+	if (hit)
+		closest_hit->obj_index = index;
+	return (hit);
+}
@@ -0,0 +1,112 @@
+#include "../../includes/minirt_app.h"
+#include "../../includes/stats.h"
+#include "../../includes/wavefront.h"
+
+/*
+** Generate stage: the primary rays of wave index, in the frame's pixel
+** order, into the wave's direction arrays
+*/
+void	wave_generate(t_wave *wave, int index)
+{
+	t_ray	ray;
+	int		pixel;
+	int		i;
+
+	wave->num_rays = 0;
+	i = -1;
+	while (++i < WAVE_SIZE)
+	{
+		pixel = wave_pixel(wave, index, i);
+		if (pixel < 0)
+			continue ;
+		ray = view_ray(&wave->view, pixel % WIDTH, pixel / WIDTH);
+		wave->dir[0][wave->num_rays] = ray.direction.x;
+		wave->dir[1][wave->num_rays] = ray.direction.y;
+		wave->dir[2][wave->num_rays] = ray.direction.z;
+		wave->pixels[wave->num_rays++] = pixel;
+	}
+	g_stats.primary_rays += wave->num_rays;
+}
+
+/*
+** Ray i of the wave, as generated
+*/
+t_ray	wave_ray(const t_wave *wave, int i)
+{
+	t_ray	ray;
+
+	ray.origin = wave->view.origin;
+	ray.direction = vec3_create(wave->dir[0][i], wave->dir[1][i],
+			wave->dir[2][i]);
+	ray.tmin = MIN_T;
+	ray.tmax = DBL_MAX;
+	return (ray);
+}
+
+/*
+** Intersect stage: trace every ray of the wave into the G-buffer; misses
+** are marked with t < 0
+*/
+void	wave_intersect(t_vars *vars, const t_scene *scene, t_wave *wave)
+{
+	t_hit	*hit;
+	int		i;
+
+	i = -1;
+	while (++i < wave->num_rays)
+	{
+		hit = &vars->gbuf.hits[wave->pixels[i]];
+		if (!trace_primary(scene, wave_ray(wave, i), hit, &wave->hints))
+			hit->t = -1.0;
+	}
+}
+
+/*
+** Compact stage: colour the sky pixels, and queue the hits for shading
+** and those facing the light for the shadow stage
+*/
+void	wave_compact(t_vars *vars, const t_scene *scene, t_wave *wave)
+{
+	const t_hit	*hit;
+	int			p;
+	int			i;
+
+	wave->num_hits = 0;
+	wave->shadows.count = 0;
+	i = -1;
+	while (++i < wave->num_rays)
+	{
+		p = wave->pixels[i];
+		hit = &vars->gbuf.hits[p];
+		vars->gbuf.ids[p] = -1;
+		vars->gbuf.lit[p] = FALSE;
+		vars->gbuf.blended[p] = FALSE;
+		if (hit->t < 0.0)
+		{
+			vars->gbuf.colors[p] = get_sky_color(wave_ray(wave, i));
+			continue ;
+		}
+		vars->gbuf.ids[p] = hit->obj_index;
+		wave->hits[wave->num_hits++] = p;
+		if (vec3_dot(hit->normal, vec3_sub(scene->light.position,
+					hit->point)) > 0.0)
+			wave->shadows.pixels[wave->shadows.count++] = p;
+	}
+}
+
+/*
+** Shade stage: light every compacted hit with its shadow state
+*/
+void	wave_shade(t_vars *vars, const t_scene *scene, const t_wave *wave)
+{
+	int	p;
+	int	i;
+
+	i = -1;
+	while (++i < wave->num_hits)
+	{
+		p = wave->hits[i];
+		vars->gbuf.colors[p] = color_to_int(calculate_lighting(scene,
+					&vars->gbuf.hits[p], vars->gbuf.lit[p]));
+	}
+}
@@ -0,0 +1,125 @@
+#include "../../includes/minirt_app.h"
+#include "../../includes/wavefront.h"
+
+/*
+** Rotate and flip a quadrant of the Hilbert curve so that its sub-curve
+** joins its neighbours'
+*/
+static void	hilbert_rotate(int *xy, int side, int rx, int ry)
+{
+	int	tmp;
+
+	if (ry != 0)
+		return ;
+	if (rx == 1)
+	{
+		xy[0] = side - 1 - xy[0];
+		xy[1] = side - 1 - xy[1];
+	}
+	tmp = xy[0];
+	xy[0] = xy[1];
+	xy[1] = tmp;
+}
+
+/*
+** Point d of the Morton or Hilbert curve over a side x side square (side
+** a power of two)
+*/
+static void	curve_point(int order, int d, int side, int *xy)
+{
+	int	s;
+	int	rx;
+	int	ry;
+
+	xy[0] = 0;
+	xy[1] = 0;
+	s = 1;
+	while (s < side)
+	{
+		rx = d & 1;
+		ry = d >> 1 & 1;
+		if (order == ORDER_HILBERT)
+		{
+			rx = d >> 1 & 1;
+			ry = (d ^ rx) & 1;
+			hilbert_rotate(xy, s, rx, ry);
+		}
+		xy[0] += s * rx;
+		xy[1] += s * ry;
+		d /= 4;
+		s *= 2;
+	}
+}
+
+/*
+** Fill out with the cells of a width x height grid, as y * width + x, in
+** the order's sequence (row by row, or along the curve) over the smallest
+** power-of-two square covering it
+*/
+static void	order_fill(int *out, int order, int width, int height)
+{
+	int	side;
+	int	count;
+	int	xy[2];
+	int	d;
+
+	side = 1;
+	while (side < width || side < height)
+		side *= 2;
+	count = 0;
+	d = -1;
+	while (++d < side * side)
+	{
+		xy[0] = d % side;
+		xy[1] = d / side;
+		if (order == ORDER_MORTON || order == ORDER_HILBERT)
+			curve_point(order, d, side, xy);
+		if (xy[0] < width && xy[1] < height)
+			out[count++] = xy[1] * width + xy[0];
+	}
+}
+
+/*
+** Lay out the frame's waves for a pixel order: the scanline order cuts
+** the rows into runs of WAVE_SIZE pixels; the others visit the screen
+** tiles, and the pixels of each tile, row by row (tiled) or along the
+** Morton or Hilbert curve, so consecutive rays stay close on screen
+*/
+void	wave_order_init(t_wave *wave, t_arena *arena, int order)
+{
+	wave->order = order;
+	wave->tile_order = arena_take(arena, sizeof(int) * TILES_X * TILES_Y);
+	wave->pixel_order = arena_take(arena, sizeof(int) * WAVE_SIZE);
+	wave->num_waves = TILES_X * TILES_Y;
+	if (order == ORDER_SCANLINE)
+	{
+		wave->num_waves = (WIDTH * HEIGHT + WAVE_SIZE - 1) / WAVE_SIZE;
+		return ;
+	}
+	order_fill(wave->tile_order, order, TILES_X, TILES_Y);
+	order_fill(wave->pixel_order, order, TILE_SIZE, TILE_SIZE);
+}
+
+/*
+** Pixel traced by ray i of wave index
+** Returns its index in the frame, or -1 if it falls off the screen
+*/
+int	wave_pixel(const t_wave *wave, int index, int i)
+{
+	int	tile;
+	int	x;
+	int	y;
+
+	if (wave->order == ORDER_SCANLINE)
+	{
+		if (index * WAVE_SIZE + i >= WIDTH * HEIGHT)
+			return (-1);
+		return (index * WAVE_SIZE + i);
+	}
+	tile = wave->tile_order[index];
+	x = tile % TILES_X * TILE_SIZE + wave->pixel_order[i] % TILE_SIZE;
+	y = tile / TILES_X * TILE_SIZE + wave->pixel_order[i] / TILE_SIZE;
+	if (x >= WIDTH || y >= HEIGHT)
+		return (-1);
+	return (y * WIDTH + x);
+}
@@ -0,0 +1,77 @@
+#include "../../includes/minirt_app.h"
+#include "../../includes/stats.h"
+#include "../../includes/wavefront.h"
+
+/*
+** Set up the wave's queues, sort keys and pixel order in the arena, for
+** the camera of this frame;
+** the shadow queue is traced in packets when the tile pass applies: it
+** needs the light's cached origin terms, scenes small enough for a
+** per-tile cull of every object, and shadow rays (not the shadow map)
+*/
+static void	wave_init(t_wave *wave, t_arena *arena, const t_vars *vars,
+		const t_scene *scene)
+{
+	int	axis;
+
+	wave->view = camera_view(scene);
+	wave->sort_rays = vars->opts.sort_rays;
+	hints_init(&wave->hints);
+	wave_order_init(wave, arena, vars->opts.order);
+	wave->keys[0] = arena_take(arena, sizeof(t_ray_key) * WAVE_SIZE);
+	wave->keys[1] = arena_take(arena, sizeof(t_ray_key) * WAVE_SIZE);
+	axis = -1;
+	while (++axis < 3)
+		wave->dir[axis] = arena_take(arena, sizeof(double) * WAVE_SIZE);
+	wave->pixels = arena_take(arena, sizeof(int) * WAVE_SIZE);
+	wave->hits = arena_take(arena, sizeof(int) * WAVE_SIZE);
+	wave->shadows.pixels = arena_take(arena, sizeof(int) * WAVE_SIZE);
+	wave->packets = scene->accel
+		&& scene->num_objects <= SHADOW_TILE_MAX_OBJECTS
+		&& !scene->accel->shadow_map.depth
+		&& origin_cache_matches(&scene->accel->light, scene->light.position);
+	wave->shadows.casters = NULL;
+	if (wave->packets)
+		wave->shadows.casters = scene->accel->tile_casters;
+}
+
+/*
+** Run the stages on one wave, timing each
+*/
+static void	trace_wave(t_vars *vars, const t_scene *scene, t_wave *wave,
+		int index)
+{
+	long	start;
+
+	start = time_now_us();
+	wave_generate(wave, index);
+	stats_stage_end(WAVE_GENERATE, &start);
+	wave_intersect(vars, scene, wave);
+	stats_stage_end(WAVE_INTERSECT, &start);
+	wave_compact(vars, scene, wave);
+	stats_stage_end(WAVE_COMPACT, &start);
+	wave_shadow(vars, scene, wave);
+	stats_stage_end(WAVE_SHADOW, &start);
+	wave_shade(vars, scene, wave);
+	stats_stage_end(WAVE_SHADE, &start);
+}
+
+/*
+** Trace every pixel with the wavefront renderer: wave by wave (screen
+** tiles, unless --order scanline), each stage runs over the whole wave's
+** queue before the next, so every kernel stays hot; the queues come from
+** one arena owned by the tracing thread (the renderer traces on one)
+*/
+void	trace_all_pixels(t_vars *vars, t_scene *scene)
+{
+	t_arena	arena;
+	t_wave	wave;
+	int		index;
+
+	arena_init(&arena, WAVE_ARENA_SIZE);
+	wave_init(&wave, &arena, vars, scene);
+	index = -1;
+	while (++index < wave.num_waves)
+		trace_wave(vars, scene, &wave, index);
+	arena_free(&arena);
+}
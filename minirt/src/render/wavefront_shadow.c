@@ -0,0 +1,58 @@
+#include "../../includes/minirt_app.h"
+#include "../../includes/wavefront.h"
+
+/*
+** Take the hits whose shadow state the light cache knows off the shadow
+** queue
+*/
+static void	queue_drop_cached(t_vars *vars, const t_scene *scene,
+		t_shadow_tile *queue)
+{
+	int	count;
+	int	p;
+	int	i;
+
+	count = 0;
+	i = -1;
+	while (++i < queue->count)
+	{
+		p = queue->pixels[i];
+		vars->gbuf.lit[p] = light_cache_lookup(scene, &vars->gbuf.hits[p]);
+		if (vars->gbuf.lit[p] < 0)
+			queue->pixels[count++] = p;
+	}
+	queue->count = count;
+}
+
+/*
+** Shadow stage: trace the shadow queue, sorted first with --sort-rays,
+** in packets against the scene
+** culled once for the tile when the tile pass applies, with the results
+** going to the light cache; otherwise through is_lit one by one, which
+** also covers the shadow map
+*/
+void	wave_shadow(t_vars *vars, const t_scene *scene, t_wave *wave)
+{
+	t_shadow_tile	*queue;
+	int				i;
+
+	queue = &wave->shadows;
+	if (wave->sort_rays)
+		wave_sort_shadows(vars, scene, wave);
+	i = -1;
+	if (!wave->packets)
+	{
+		while (++i < queue->count)
+			vars->gbuf.lit[queue->pixels[i]] = is_lit(scene,
+					&vars->gbuf.hits[queue->pixels[i]], &wave->hints);
+		return ;
+	}
+	queue_drop_cached(vars, scene, queue);
+	if (queue->count == 0)
+		return ;
+	shadow_tile_cull(scene, vars->gbuf.hits, queue);
+	shadow_tile_trace(scene, vars->gbuf.hits, queue, vars->gbuf.lit);
+	while (++i < queue->count)
+		light_cache_store(scene, &vars->gbuf.hits[queue->pixels[i]],
+			vars->gbuf.lit[queue->pixels[i]]);
+}
@@ -0,0 +1,137 @@
+#include "../../includes/minirt_app.h"
+#include "../../includes/wavefront.h"
+
+/*
+** Bounds of the hit points in the shadow queue
+*/
+static t_aabb	queue_bounds(const t_hit *hits, const t_shadow_tile *queue)
+{
+	t_aabb	box;
+	t_aabb	point;
+	int		i;
+
+	box.min = hits[queue->pixels[0]].point;
+	box.max = box.min;
+	i = 0;
+	while (++i < queue->count)
+	{
+		point.min = hits[queue->pixels[i]].point;
+		point.max = point.min;
+		box = aabb_union(box, point);
+	}
+	return (box);
+}
+
+/*
+** Sort key of the shadow ray to a hit point: the octant of its direction
+** from the light, then the Morton code of the point within the queue's
+** bounds (shadow rays all start at the light, so their far ends are
+** what tells them apart)
+*/
+static unsigned long	ray_key(t_point3 point, const t_aabb *box,
+		t_point3 light)
+{
+	unsigned long	octant;
+	unsigned int	cell[3];
+	double			extent;
+	int				axis;
+
+	octant = (point.x < light.x) << 2 | (point.y < light.y) << 1
+		| (point.z < light.z);
+	axis = -1;
+	while (++axis < 3)
+	{
+		extent = vec3_component(box->max, axis)
+			- vec3_component(box->min, axis);
+		cell[axis] = 0;
+		if (extent > 0.0)
+			cell[axis] = (unsigned int)((vec3_component(point, axis)
+						- vec3_component(box->min, axis)) / extent
+					* ((1u << MORTON_BITS) - 1));
+	}
+	return (octant << (3 * MORTON_BITS) | morton_expand(cell[0]) << 2
+		| morton_expand(cell[1]) << 1 | morton_expand(cell[2]));
+}
+
+/*
+** Merge the sorted runs src[run[0], run[1]) and src[run[1], run[2])
+** into dst, keeping equal keys in their original order
+*/
+static void	merge_keys(const t_ray_key *src, t_ray_key *dst, const int *run)
+{
+	int	i;
+	int	j;
+	int	k;
+
+	i = run[0];
+	j = run[1];
+	k = run[0];
+	while (k < run[2])
+	{
+		if (j >= run[2] || (i < run[1] && src[i].key <= src[j].key))
+			dst[k++] = src[i++];
+		else
+			dst[k++] = src[j++];
+	}
+}
+
+/*
+** Stable bottom-up merge sort of the first count keys, ping-ponging
+** between the wave's two key buffers; the result ends in keys[0]
+*/
+static void	sort_keys(t_wave *wave, int count)
+{
+	t_ray_key	*tmp;
+	int			run[3];
+	int			width;
+
+	width = 1;
+	while (width < count)
+	{
+		run[0] = 0;
+		while (run[0] < count)
+		{
+			run[1] = run[0] + width;
+			if (run[1] > count)
+				run[1] = count;
+			run[2] = run[0] + 2 * width;
+			if (run[2] > count)
+				run[2] = count;
+			merge_keys(wave->keys[0], wave->keys[1], run);
+			run[0] = run[2];
+		}
+		tmp = wave->keys[0];
+		wave->keys[0] = wave->keys[1];
+		wave->keys[1] = tmp;
+		width *= 2;
+	}
+}
+
+/*
+** Reorder the shadow queue by direction octant and Morton code, so rays
+** traced together (in one packet, or one after the other) head for the
+** same part of the scene and walk the same nodes
+*/
+void	wave_sort_shadows(const t_vars *vars, const t_scene *scene,
+		t_wave *wave)
+{
+	t_shadow_tile	*queue;
+	t_aabb			box;
+	int				i;
+
+	queue = &wave->shadows;
+	if (queue->count < 2)
+		return ;
+	box = queue_bounds(vars->gbuf.hits, queue);
+	i = -1;
+	while (++i < queue->count)
+	{
+		wave->keys[0][i].pixel = queue->pixels[i];
+		wave->keys[0][i].key = ray_key(vars->gbuf.hits[queue->pixels[i]].point,
+				&box, scene->light.position);
+	}
+	sort_keys(wave, queue->count);
+	i = -1;
+	while (++i < queue->count)
+		queue->pixels[i] = wave->keys[0][i].pixel;
+}
@@ -0,0 +1,42 @@
+#include "../includes/minirt_app.h"
+#include "../includes/wavefront.h"
+
+/*
+** Allocate the arena's block
+*/
+void	arena_init(t_arena *arena, size_t size)
+{
+	arena->base = malloc(size);
+	if (!arena->base)
+		error_exit(ERR_MEMORY);
+	arena->size = size;
+	arena->used = 0;
+}
+
+/*
+** Take size bytes from the arena, aligned to ARENA_ALIGN; the caller
+** sizes the block for everything it takes
+*/
+void	*arena_take(t_arena *arena, size_t size)
+{
+	void	*ptr;
+
+	arena->used = (arena->used + ARENA_ALIGN - 1)
+		& ~(size_t)(ARENA_ALIGN - 1);
+	if (arena->used + size > arena->size)
+		error_exit(ERR_MEMORY);
+	ptr = arena->base + arena->used;
+	arena->used += size;
+	return (ptr);
+}
+
+/*
+** Release the arena's block and everything taken from it
+*/
+void	arena_free(t_arena *arena)
+{
+	free(arena->base);
+	arena->base = NULL;
+	arena->size = 0;
+	arena->used = 0;
+}
@@ -0,0 +1,14 @@
+#include <unistd.h>
+
+/*
+** Number of online CPU cores, at least 1
+*/
+int	cpu_count(void)
+{
+	long	cores;
+
+	cores = sysconf(_SC_NPROCESSORS_ONLN);
+	if (cores < 1)
+		return (1);
+	return ((int)cores);
+}
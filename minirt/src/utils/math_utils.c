@@ -3,24 +3,32 @@
 
 /**
  * Helper function to solve quadratic equation ax^2 + bx + c = 0
- * Returns the smallest positive root > min_t, or -1 if none
+ * Returns the smallest root inside (tmin, tmax), or -1 if none; when the
+ * nearer root is already past tmax the farther one is not considered
  */
-double	solve_quadratic(double a, double b, double c, double min_t)
+double	solve_quadratic(t_quadratic q, double tmin, double tmax)
 {
 	double	discriminant;
 	double	sqrt_d;
 	double	t0;
 	double	t1;
 
-	discriminant = b * b - 4 * a * c;
+	discriminant = q.b * q.b - 4 * q.a * q.c;
 	if (discriminant < 0)
 		return (-1.0);
 	sqrt_d = sqrt(discriminant);
-	t0 = (-b - sqrt_d) / (2.0 * a);
-	t1 = (-b + sqrt_d) / (2.0 * a);
-	if (t0 > min_t && (t0 < t1 || t1 <= min_t))
+	t0 = (-q.b - sqrt_d) / (2.0 * q.a);
+	t1 = (-q.b + sqrt_d) / (2.0 * q.a);
+	if (t1 < t0)
+	{
+		t0 = t1;
+		t1 = (-q.b - sqrt_d) / (2.0 * q.a);
+	}
+	if (t0 >= tmax)
+		return (-1.0);
+	if (t0 > tmin)
 		return (t0);
-	if (t1 > min_t)
+	if (t1 > tmin && t1 < tmax)
 		return (t1);
 	return (-1.0);
 }
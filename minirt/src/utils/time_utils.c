@@ -0,0 +1,24 @@
+#include <stddef.h>
+#include <sys/time.h>
+
+/*
+** Current wall-clock time in milliseconds
+*/
+long	time_now_ms(void)
+{
+	struct timeval	tv;
+
+	gettimeofday(&tv, NULL);
+	return (tv.tv_sec * 1000L + tv.tv_usec / 1000L);
+}
+
+/*
+** Current wall-clock time in microseconds, for timing short stages
+*/
+long	time_now_us(void)
+{
+	struct timeval	tv;
+
+	gettimeofday(&tv, NULL);
+	return (tv.tv_sec * 1000000L + tv.tv_usec);
+}
@@ -1,4 +1,5 @@
 #include "../includes/scene_math.h"
+#include "../includes/accel.h"
 #include <stdio.h>
 
 /*
@@ -156,6 +157,7 @@ void	scene_translate_object(t_scene *scene, int obj_index, t_vec3 delta)
 			&transform);
 	else if (scene->objects[obj_index].type == CONE)
 		transform_cone(&scene->objects[obj_index].data.cone, &transform);
+	accel_update_object(scene, obj_index);
 }
 
 /*
@@ -200,6 +202,7 @@ void	scene_rotate_object(t_scene *scene, int obj_index, t_vec3 rotation)
 				axis, angle);
 		scene->objects[obj_index].data.cone.axis = vec3_normalize(scene->objects[obj_index].data.cone.axis);
 	}
+	accel_update_object(scene, obj_index);
 }
 
 /*
@@ -220,6 +223,7 @@ void	scene_scale_object(t_scene *scene, int obj_index, double scale)
 			&transform);
 	else if (scene->objects[obj_index].type == CONE)
 		transform_cone(&scene->objects[obj_index].data.cone, &transform);
+	accel_update_object(scene, obj_index);
 }
 
 /*
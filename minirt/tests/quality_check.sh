@@ -0,0 +1,28 @@
+#!/bin/sh
+# Subsampling quality check: render each scene with every --accel mode
+# through --quality-check, which exits with failure when the subsampled
+# frame's PSNR against the full render is below QUALITY_MIN_PSNR
+# Usage: quality_check.sh [path/to/miniRT] (run from tests/)
+
+MINIRT=${1:-../miniRT}
+SCENES="box_interior columned_hall test_all_primitives test_caps_side
+	sphere_scenes/test_sphere_field"
+MODES="none bvh wbvh grid lazy"
+failed=0
+
+for scene in $SCENES; do
+	for mode in $MODES; do
+		out=$("$MINIRT" "../scenes/$scene.rt" --quality-check \
+			--accel "$mode" 2>&1)
+		status=$?
+		quality=$(echo "$out" | grep "Subsample quality" | sed 's/.*, //')
+		if [ $status -eq 0 ] && [ -n "$quality" ]; then
+			echo "ok   $scene --accel $mode: $quality"
+		else
+			echo "FAIL $scene --accel $mode (status $status)"
+			echo "$out" | tail -n 3
+			failed=1
+		fi
+	done
+done
+exit $failed